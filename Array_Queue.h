@@ -1,4 +1,4 @@
-2//
+//
 // Created by eyadd on 2025-04-20.
 //
 
@@ -11,7 +11,7 @@
 using namespace std;
 
 template <class t>
-class Queue {
+class Array_Queue {
 private:
     int MAX_LENGTH;
     int rear;
@@ -20,8 +20,15 @@ private:
     t *array;
 
 public:
-    Queue(unsigned int size): MAX_LENGTH(size), rear(MAX_LENGTH - 1), front(0), length(0), array(new t[MAX_LENGTH]) {};
-    Queue(): MAX_LENGTH(100), rear(MAX_LENGTH - 1), front(0), length(0), array(new t[MAX_LENGTH]) {};
+    Array_Queue(unsigned int size): MAX_LENGTH(size), rear(MAX_LENGTH - 1), front(0), length(0), array(new t[MAX_LENGTH]) {};
+    Array_Queue(): MAX_LENGTH(100), rear(MAX_LENGTH - 1), front(0), length(0), array(new t[MAX_LENGTH]) {};
+
+    Array_Queue(const Array_Queue&) = delete;
+    Array_Queue& operator=(const Array_Queue&) = delete;
+
+    ~Array_Queue() {
+        delete[] array;
+    }
 
     bool empty() {
         return length == 0;
@@ -48,7 +55,7 @@ public:
             --length;
         }
         else {
-            cout << "Queue is full at Dequeue!" << endl;
+            cout << "Queue is empty at Dequeue!" << endl;
         }
     }
 
@@ -59,7 +66,7 @@ public:
             --length;
         }
         else {
-            cout << "Queue is full at Dequeue!" << endl;
+            cout << "Queue is empty at Dequeue!" << endl;
         }
     }
 
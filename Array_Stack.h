@@ -5,12 +5,86 @@
 #ifndef ARRAY_STACK_H
 #define ARRAY_STACK_H
 
+#include <iostream>
+#include <cassert>
 
+using namespace std;
 
+template <class t>
 class Array_Stack {
+private:
+    int MAX_LENGTH;
+    int length;
+    t *array;
 
-};
+public:
+    Array_Stack(unsigned int size): MAX_LENGTH(size), length(0), array(new t[MAX_LENGTH]) {};
+    Array_Stack(): MAX_LENGTH(100), length(0), array(new t[MAX_LENGTH]) {};
+
+    Array_Stack(const Array_Stack&) = delete;
+    Array_Stack& operator=(const Array_Stack&) = delete;
+
+    ~Array_Stack() {
+        delete[] array;
+    }
+
+    bool empty() {
+        return length == 0;
+    }
+
+    bool isfull() {
+        return length == MAX_LENGTH;
+    }
+
+    void push(t new_item) {
+        if (!isfull()) {
+            array[length] = new_item;
+            ++length;
+        }
+        else {
+            cout << "Stack is full at Stack Push" << endl;
+        }
+    }
 
+    void pop() {
+        if (!empty()) {
+            --length;
+        }
+        else {
+            cout << "Stack is empty at Stack Pop" << endl;
+        }
+    }
 
+    void pop(t& item_copy) {
+        if (!empty()) {
+            --length;
+            item_copy = array[length];
+        }
+        else {
+            cout << "Stack is empty at Stack Pop" << endl;
+        }
+    }
+
+    void clear() {
+        length = 0;
+    }
+
+    t get_top() {
+        assert(!empty());
+        return array[length - 1];
+    }
+
+    int get_length() {
+        return length;
+    }
+
+    void print() {
+        cout << "[ ";
+        for (int i = length - 1; i >= 0; --i) {
+            cout << array[i] << " ";
+        }
+        cout << "]" << endl;
+    }
+};
 
 #endif //ARRAY_STACK_H
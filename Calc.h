@@ -4,104 +4,155 @@
 
 #ifndef CALC_H
 #define CALC_H
-#include "Linked_Stack.h"
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Calc_Program.h"
 
 using namespace std;
 
-bool piority(char c1, char c2) {
-    if ((c1 == '(' ) || ((c1 == '*' || c1 == '/') && c2 != '(') || (c1 == '+' || c1 == '-') && (c2 != '(' && c2 != '/' && c2 != '*')) {
-        return true;
-    }
+namespace calc_detail {
 
-    return false;
+inline int infix_precedence(char op) {
+    return (op == '*' || op == '/') ? 2 : 1;
 }
 
-string infix_to_postfix (const string &str) {
-    Stack<char> ope;
-    string result;
-    result;
+// Finds the end of the number token at str[i]: digits with an optional
+// fraction and exponent, as std::from_chars reads them for doubles
+inline size_t number_end(string_view str, size_t i) {
+    auto digits = [&](size_t j) {
+        while (j < str.size() && is_digit(str[j])) ++j;
+        return j;
+    };
+    i = digits(i);
+    if (i < str.size() && str[i] == '.') i = digits(i + 1);
+    if (i < str.size() && (str[i] == 'e' || str[i] == 'E')) {
+        size_t j = i + 1;
+        if (j < str.size() && (str[j] == '+' || str[j] == '-')) ++j;
+        if (j < str.size() && is_digit(str[j])) i = digits(j);
+    }
+    return i;
+}
 
-    for (size_t i = 0; i < str.size(); ++i) {
-        if (isdigit(str.at(i))) {
-            string temp;
-            while (i < str.size() && isdigit(str.at(i))) {
-                temp += str.at(i);
-                ++i;
-            }
-            result = result + ' ' + temp;
-            if (i >= str.size()) break;
+} // namespace calc_detail
+
+// Converts an infix expression to space-separated postfix in one pass and
+// writes the characters to out. Number tokens (including decimals such as
+// 2.5e3) are copied straight from slices of the input, so the only
+// allocation is the operator stack.
+template <class OutputIt>
+OutputIt infix_to_postfix(string_view str, OutputIt out) {
+    vector<char> ope;
+    ope.reserve(str.size());
+    bool first = true;
+    auto write_token = [&](string_view token) {
+        if (!first) {
+            *out++ = ' ';
         }
-
-        if (str.at(i) == ')') {
-            while (ope.get_top() != '(') {
-                result = result + ' ' + ope.get_top();
-                ope.pop();
+        first = false;
+        out = copy(token.begin(), token.end(), out);
+    };
+    auto write_operator = [&]() {
+        char op = ope.back();
+        ope.pop_back();
+        write_token(string_view(&op, 1));
+    };
+
+    for (size_t i = 0; i < str.size();) {
+        char c = str[i];
+        if (calc_detail::is_digit(c) || c == '.') {
+            size_t start = i;
+            i = calc_detail::number_end(str, i);
+            if (i - start == 1 && c == '.') {
+                throw invalid_argument("Unexpected character in infix_to_postfix()");
             }
-            ope.pop();
+            write_token(str.substr(start, i - start));
             continue;
         }
-        if (!ope.empty() && piority(ope.get_top(), str.at(i)) && !isspace(str.at(i)) && ope.get_top() != '(') {
-            result = result + ' ' + ope.get_top();
-            ope.pop();
-        }
-        if (!isspace(str.at(i))) {
-            ope.push(str.at(i));
-        }
+        if (c == '(') {
+            ope.push_back(c);
+        } else if (c == ')') {
+            while (!ope.empty() && ope.back() != '(') {
+                write_operator();
+            }
+            if (ope.empty()) {
+                throw invalid_argument("Unbalanced parentheses in infix_to_postfix()");
+            }
+            ope.pop_back();
+        } else if (c == '+' || c == '-' || c == '*' || c == '/') {
+            // Pop every operator that binds at least as tightly, not just the top one
+            while (!ope.empty() && ope.back() != '(' &&
+                   calc_detail::infix_precedence(ope.back()) >= calc_detail::infix_precedence(c)) {
+                write_operator();
+            }
+            ope.push_back(c);
+        } else if (!isspace(static_cast<unsigned char>(c))) {
+            throw invalid_argument("Unexpected character in infix_to_postfix()");
         }
-
-    result.erase(result.begin());
+        ++i;
+    }
 
     while (!ope.empty()) {
-        result = result + ' ' + ope.get_top();
-        ope.pop();
+        if (ope.back() == '(') {
+            throw invalid_argument("Unbalanced parentheses in infix_to_postfix()");
+        }
+        write_operator();
     }
-    return result;
+    return out;
 }
 
-long expression_evaluation(string str) {
-    Stack<long int> opa;
+// The output has at most one separator per token, so twice the input size
+// is always enough and the string is allocated once.
+inline string infix_to_postfix(string_view str) {
+    string result;
+    result.reserve(2 * str.size());
+    infix_to_postfix(str, back_inserter(result));
+    return result;
+}
 
-    for (size_t i = 0; i < str.size(); ++i) {
-        if (isdigit(str.at(i))) {
-            while (i < str.size() && isdigit(str.at(i))) {
-                opa.push(str.at(i) - '0');
-                ++i;
+// Evaluates space-separated postfix such as the output of infix_to_postfix.
+// Numbers of any length are read with from_chars (decimals when Num is a
+// floating type), and integer arithmetic reports overflow instead of wrapping.
+template <class Num = long>
+Num expression_evaluation(string_view str) {
+    vector<Num> operands;
+    operands.reserve(str.size() / 2 + 1);
+
+    for (size_t i = 0; i < str.size();) {
+        char c = str[i];
+        if (calc_detail::is_digit(c) || c == '.') {
+            Num value{};
+            Calc_Status status = calc_detail::parse_number(str, i, value);
+            if (status != Calc_Status::ok) {
+                throw invalid_argument(string("Cannot read number in expression_evaluation(): ") +
+                                       calc_status_message(status));
             }
-            if (i >= str.size()) break;
+            operands.push_back(value);
+            continue;
         }
-        switch (str.at(i)) {
-            long num1, num2;
-
-            case '+':
-                opa.pop(num1);
-                opa.pop(num2);
-                opa.push(num1 + num2);
-                ++i;
-                break;
-
-            case '-':
-                opa.pop(num1);
-                opa.pop(num2);
-                opa.push(num1 - num2);
-                ++i;
-                break;
-
-            case '*':
-                opa.pop(num1);
-                opa.pop(num2);
-                opa.push(num1 * num2);
-                ++i;
-                break;
-
-            case '/':
-                opa.pop(num1);
-                opa.pop(num2);
-                opa.push(num1 / num2);
-                ++i;
-                break;
+        if (c == '+' || c == '-' || c == '*' || c == '/') {
+            if (operands.size() < 2) {
+                throw invalid_argument("Missing operand in expression_evaluation()");
+            }
+            Num right = operands.back();
+            operands.pop_back();
+            Calc_Status status = calc_detail::apply(calc_detail::to_op(c), operands.back(), right, operands.back());
+            if (status != Calc_Status::ok) {
+                throw runtime_error(string("Cannot evaluate expression: ") + calc_status_message(status));
+            }
+        } else if (!isspace(static_cast<unsigned char>(c))) {
+            throw invalid_argument("Unexpected character in expression_evaluation()");
         }
+        ++i;
     }
 
-    return opa.get_top();
+    if (operands.size() != 1) {
+        throw invalid_argument("Malformed postfix in expression_evaluation()");
+    }
+    return operands.back();
 }
 #endif //CALC_H
@@ -0,0 +1,135 @@
+/**
+ * @file Calc_Batch.h
+ * @brief Evaluate many independent Calc expressions across a thread pool
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * The batch functions write one result and one Calc_Status per expression
+ * into arrays the caller allocates up front. Each worker thread keeps its own
+ * program and operator scratch, so once those have grown to the largest
+ * expression seen, evaluating a batch allocates nothing per expression.
+ */
+
+#ifndef CALC_BATCH_H
+#define CALC_BATCH_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "Calc_Program.h"
+#include "Parallel.h"
+
+namespace calc_detail {
+
+template <class Num>
+struct Batch_Scratch {
+    Calc_Program<Num> program;
+    std::vector<char> operators;
+};
+
+template <class Num>
+Batch_Scratch<Num>& thread_scratch() {
+    thread_local Batch_Scratch<Num> scratch;
+    return scratch;
+}
+
+template <class Num>
+Calc_Status evaluate_one(std::string_view expression, Num& result) {
+    Batch_Scratch<Num>& scratch = thread_scratch<Num>();
+    Calc_Status status = calc_compile(expression, scratch.program, scratch.operators);
+    if (status != Calc_Status::ok) {
+        result = Num();
+        return status;
+    }
+    status = calc_evaluate(scratch.program, result);
+    if (status != Calc_Status::ok) {
+        result = Num();
+    }
+    return status;
+}
+
+} // namespace calc_detail
+
+/**
+ * @brief Evaluate a span of expressions in parallel
+ * @param pool The pool to run on
+ * @param expressions Pointer to the first expression
+ * @param count Number of expressions
+ * @param results Room for count values; failed items get Num()
+ * @param statuses Room for count statuses, or nullptr to skip them
+ * @param grain Largest number of expressions handed to one task, or 0 to choose automatically
+ * @return The number of expressions that failed
+ */
+template <class Num>
+size_t evaluate_batch(Thread_Pool& pool, const std::string_view* expressions, size_t count, Num* results,
+                      Calc_Status* statuses, size_t grain = 0) {
+    std::atomic<size_t> failures(0);
+    parallel_for(pool, count, [&](size_t begin, size_t end) {
+        size_t failed = 0;
+        for (size_t i = begin; i < end; ++i) {
+            Calc_Status status = calc_detail::evaluate_one(expressions[i], results[i]);
+            if (statuses != nullptr) statuses[i] = status;
+            failed += status != Calc_Status::ok;
+        }
+        failures.fetch_add(failed, std::memory_order_relaxed);
+    }, grain == 0 ? std::max<size_t>(64, count / (pool.size() * 8) + 1) : grain);
+    return failures.load();
+}
+
+template <class Num>
+size_t evaluate_batch(const std::string_view* expressions, size_t count, Num* results, Calc_Status* statuses,
+                      size_t grain = 0) {
+    return evaluate_batch(Thread_Pool::shared(), expressions, count, results, statuses, grain);
+}
+
+/**
+ * @brief Split a buffer into lines without copying
+ * @param buffer Newline-separated text; a final line without a newline is included
+ * @return One string_view per line, with any trailing '\r' removed
+ */
+inline std::vector<std::string_view> split_lines(std::string_view buffer) {
+    std::vector<std::string_view> lines;
+    const char* position = buffer.data();
+    const char* end = buffer.data() + buffer.size();
+    while (position < end) {
+        const char* newline = static_cast<const char*>(std::memchr(position, '\n', static_cast<size_t>(end - position)));
+        const char* line_end = newline != nullptr ? newline : end;
+        std::string_view line(position, static_cast<size_t>(line_end - position));
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        lines.push_back(line);
+        position = newline != nullptr ? newline + 1 : end;
+    }
+    return lines;
+}
+
+/**
+ * @brief Evaluate every line of a newline-separated buffer in parallel
+ * @param pool The pool to run on
+ * @param buffer One expression per line
+ * @param results Receives one value per line
+ * @param statuses Receives one status per line, or nullptr to skip them
+ * @param grain Largest number of lines handed to one task, or 0 to choose automatically
+ * @return The number of lines that failed
+ */
+template <class Num>
+size_t evaluate_lines(Thread_Pool& pool, std::string_view buffer, std::vector<Num>& results,
+                      std::vector<Calc_Status>* statuses = nullptr, size_t grain = 0) {
+    std::vector<std::string_view> lines = split_lines(buffer);
+    results.resize(lines.size());
+    if (statuses != nullptr) statuses->resize(lines.size());
+    return evaluate_batch(pool, lines.data(), lines.size(), results.data(),
+                          statuses != nullptr ? statuses->data() : nullptr, grain);
+}
+
+template <class Num>
+size_t evaluate_lines(std::string_view buffer, std::vector<Num>& results,
+                      std::vector<Calc_Status>* statuses = nullptr, size_t grain = 0) {
+    return evaluate_lines(Thread_Pool::shared(), buffer, results, statuses, grain);
+}
+
+#endif // CALC_BATCH_H
@@ -0,0 +1,286 @@
+/**
+ * @file Calc_Cache.h
+ * @brief Bounded LRU caches of compiled Calc programs keyed by expression text
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * When the same expressions arrive again and again, a cache hit skips parsing
+ * entirely: lookups hash the string_view and compare against the stored text
+ * without building a std::string. Programs are handed out as shared pointers
+ * so an entry evicted while someone still evaluates it stays alive.
+ */
+
+#ifndef CALC_CACHE_H
+#define CALC_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Calc_Program.h"
+
+/**
+ * @brief Counters describing how a cache has been used
+ */
+struct Calc_Cache_Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    size_t size = 0;
+    size_t capacity = 0;
+};
+
+/**
+ * @brief A single-threaded LRU cache from expression text to compiled program
+ * @tparam Num The arithmetic type the programs are compiled for
+ */
+template <class Num = long>
+class Calc_Cache {
+public:
+    using Program_Ptr = std::shared_ptr<const Calc_Program<Num>>;
+
+private:
+    struct Entry {
+        std::string text;
+        Program_Ptr program;
+    };
+
+    // Most recently used first; the map's keys view the text stored in each entry
+    std::list<Entry> entries;
+    std::unordered_map<std::string_view, typename std::list<Entry>::iterator> index;
+    size_t max_entries;
+    size_t hit_count;
+    size_t miss_count;
+    size_t eviction_count;
+
+public:
+    /**
+     * @brief Construct an empty cache
+     * @param capacity The most programs kept at once
+     * @throw std::invalid_argument if capacity is zero
+     */
+    explicit Calc_Cache(size_t capacity = 1024)
+        : max_entries(capacity), hit_count(0), miss_count(0), eviction_count(0) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Calc_Cache capacity must be positive");
+        }
+        index.reserve(capacity);
+    }
+
+    Calc_Cache(const Calc_Cache&) = delete;
+    Calc_Cache& operator=(const Calc_Cache&) = delete;
+
+    /**
+     * @brief Look up a program without compiling on a miss
+     * @param text The expression text
+     * @return The cached program, or nullptr (counted as a miss)
+     */
+    Program_Ptr find(std::string_view text) {
+        auto found = index.find(text);
+        if (found == index.end()) {
+            ++miss_count;
+            return nullptr;
+        }
+        ++hit_count;
+        entries.splice(entries.begin(), entries, found->second);
+        return found->second->program;
+    }
+
+    /**
+     * @brief Store a program, evicting the least recently used one if full
+     * @param text The expression text
+     * @param program The compiled program
+     * @return The program now cached under text (an existing entry wins)
+     */
+    Program_Ptr insert(std::string_view text, Program_Ptr program) {
+        auto found = index.find(text);
+        if (found != index.end()) {
+            entries.splice(entries.begin(), entries, found->second);
+            return found->second->program;
+        }
+        entries.push_front(Entry{std::string(text), std::move(program)});
+        index.emplace(std::string_view(entries.front().text), entries.begin());
+        if (entries.size() > max_entries) {
+            index.erase(std::string_view(entries.back().text));
+            entries.pop_back();
+            ++eviction_count;
+        }
+        return entries.front().program;
+    }
+
+    /**
+     * @brief Get the compiled program for text, compiling and caching it on a miss
+     * @param text The expression text
+     * @return The compiled program
+     * @throw std::invalid_argument if the expression is malformed; failures are not cached
+     */
+    Program_Ptr get(std::string_view text) {
+        Program_Ptr program = find(text);
+        if (program != nullptr) {
+            return program;
+        }
+        return insert(text, std::make_shared<const Calc_Program<Num>>(compile<Num>(text)));
+    }
+
+    /**
+     * @brief Compile through the cache and evaluate
+     * @param text The expression text
+     * @param values One value per variable of the program, or nullptr if it has none
+     * @return The value of the expression
+     * @throw std::invalid_argument or std::runtime_error as compile() and evaluate() do
+     */
+    Num evaluate(std::string_view text, const Num* values = nullptr) {
+        return ::evaluate(*get(text), values);
+    }
+
+    /**
+     * @brief Remove every entry; the counters are kept
+     */
+    void clear() noexcept {
+        index.clear();
+        entries.clear();
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return entries.size();
+    }
+
+    [[nodiscard]] size_t capacity() const noexcept {
+        return max_entries;
+    }
+
+    /**
+     * @brief Get the hit, miss and eviction counters
+     */
+    [[nodiscard]] Calc_Cache_Stats stats() const noexcept {
+        Calc_Cache_Stats result;
+        result.hits = hit_count;
+        result.misses = miss_count;
+        result.evictions = eviction_count;
+        result.size = entries.size();
+        result.capacity = max_entries;
+        return result;
+    }
+};
+
+/**
+ * @brief A thread-safe LRU cache split into independently locked shards
+ *
+ * Each expression maps to one shard by hash, so threads working on different
+ * expressions rarely touch the same lock. A miss compiles outside the lock;
+ * if two threads race on the same text, the first insert wins.
+ *
+ * @tparam Num The arithmetic type the programs are compiled for
+ */
+template <class Num = long>
+class Sharded_Calc_Cache {
+public:
+    using Program_Ptr = typename Calc_Cache<Num>::Program_Ptr;
+
+private:
+    struct Shard {
+        std::mutex lock;
+        Calc_Cache<Num> cache;
+
+        explicit Shard(size_t capacity) : cache(capacity) {}
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    Shard& shard_for(std::string_view text) {
+        // Mix the hash so shard choice is independent of the buckets inside the shard;
+        // in 64 bits, since the shard comes from the high half even where size_t is 32 bits
+        uint64_t hash = static_cast<uint64_t>(std::hash<std::string_view>()(text)) * 0x9E3779B97F4A7C15ULL;
+        return *shards[static_cast<size_t>(hash >> 32) % shards.size()];
+    }
+
+public:
+    /**
+     * @brief Construct an empty cache
+     * @param capacity The most programs kept at once, split evenly across shards
+     * @param shard_count Number of independently locked shards
+     * @throw std::invalid_argument if either argument is zero
+     */
+    explicit Sharded_Calc_Cache(size_t capacity = 16384, size_t shard_count = 16) {
+        if (capacity == 0 || shard_count == 0) {
+            throw std::invalid_argument("Sharded_Calc_Cache capacity and shard count must be positive");
+        }
+        size_t per_shard = (capacity + shard_count - 1) / shard_count;
+        for (size_t i = 0; i < shard_count; ++i) {
+            shards.push_back(std::make_unique<Shard>(per_shard));
+        }
+    }
+
+    /**
+     * @brief Get the compiled program for text, compiling and caching it on a miss
+     * @param text The expression text
+     * @return The compiled program
+     * @throw std::invalid_argument if the expression is malformed; failures are not cached
+     */
+    Program_Ptr get(std::string_view text) {
+        Shard& shard = shard_for(text);
+        {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            Program_Ptr program = shard.cache.find(text);
+            if (program != nullptr) {
+                return program;
+            }
+        }
+        Program_Ptr program = std::make_shared<const Calc_Program<Num>>(compile<Num>(text));
+        std::lock_guard<std::mutex> guard(shard.lock);
+        return shard.cache.insert(text, std::move(program));
+    }
+
+    /**
+     * @brief Compile through the cache and evaluate
+     * @param text The expression text
+     * @param values One value per variable of the program, or nullptr if it has none
+     * @return The value of the expression
+     */
+    Num evaluate(std::string_view text, const Num* values = nullptr) {
+        return ::evaluate(*get(text), values);
+    }
+
+    /**
+     * @brief Remove every entry from every shard; the counters are kept
+     */
+    void clear() {
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> guard(shard->lock);
+            shard->cache.clear();
+        }
+    }
+
+    [[nodiscard]] size_t shard_count() const noexcept {
+        return shards.size();
+    }
+
+    /**
+     * @brief Get the counters summed over all shards
+     */
+    [[nodiscard]] Calc_Cache_Stats stats() const {
+        Calc_Cache_Stats total;
+        for (const auto& shard : shards) {
+            std::lock_guard<std::mutex> guard(shard->lock);
+            Calc_Cache_Stats part = shard->cache.stats();
+            total.hits += part.hits;
+            total.misses += part.misses;
+            total.evictions += part.evictions;
+            total.size += part.size;
+            total.capacity += part.capacity;
+        }
+        return total;
+    }
+};
+
+#endif // CALC_CACHE_H
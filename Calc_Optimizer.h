@@ -0,0 +1,308 @@
+/**
+ * @file Calc_Optimizer.h
+ * @brief Constant folding, common-subexpression elimination and algebraic identities for Calc programs
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * optimize() rebuilds a program's postfix code as an expression DAG. Every
+ * node is hash-consed, so identical subexpressions (with the operands of + and
+ * * put in a canonical order) become one node. Constant subtrees are folded
+ * while the DAG is built and identities such as x*1 and x+0 are dropped. The
+ * DAG is then emitted back as bytecode; a non-leaf node used more than once is
+ * computed once and kept in a local slot for its later uses.
+ */
+
+#ifndef CALC_OPTIMIZER_H
+#define CALC_OPTIMIZER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Calc_Program.h"
+
+/**
+ * @brief What an optimize() call changed
+ */
+struct Calc_Optimize_Stats {
+    size_t nodes_before = 0;   ///< Instructions in the original program
+    size_t nodes_after = 0;    ///< Distinct expression nodes left after optimization
+    size_t folded = 0;         ///< Operations replaced by a constant
+    size_t identities = 0;     ///< Operations removed by an algebraic identity
+    size_t shared = 0;         ///< Repeated subexpressions merged into an existing node
+};
+
+namespace calc_detail {
+
+template <class Num>
+struct Dag_Node {
+    Calc_Op op;        // push_constant, load_variable or a binary operation
+    uint32_t left;     // variable index for load_variable
+    uint32_t right;
+    Num value;         // constant value for push_constant, Num() otherwise
+};
+
+template <class Num>
+struct Dag_Node_Hash {
+    size_t operator()(const Dag_Node<Num>& node) const noexcept {
+        unsigned char bytes[sizeof(Num)];
+        std::memcpy(bytes, &node.value, sizeof(Num));
+        uint64_t hash = 1469598103934665603ULL;
+        auto mix = [&hash](uint64_t part) { hash = (hash ^ part) * 1099511628211ULL; };
+        mix(static_cast<uint64_t>(node.op));
+        mix(node.left);
+        mix(node.right);
+        for (unsigned char byte : bytes) mix(byte);
+        return static_cast<size_t>(hash);
+    }
+};
+
+// Constants compare by bit pattern so 0.0 and -0.0 stay distinct
+template <class Num>
+struct Dag_Node_Equal {
+    bool operator()(const Dag_Node<Num>& a, const Dag_Node<Num>& b) const noexcept {
+        return a.op == b.op && a.left == b.left && a.right == b.right &&
+               std::memcmp(&a.value, &b.value, sizeof(Num)) == 0;
+    }
+};
+
+template <class Num>
+class Dag_Builder {
+public:
+    std::vector<Dag_Node<Num>> nodes;
+    std::vector<bool> may_fail;   // evaluating the subtree can fail with division by zero or overflow
+    Calc_Optimize_Stats stats;
+
+private:
+    std::unordered_map<Dag_Node<Num>, uint32_t, Dag_Node_Hash<Num>, Dag_Node_Equal<Num>> index;
+
+    bool is_constant(uint32_t id) const {
+        return nodes[id].op == Calc_Op::push_constant;
+    }
+
+    // Bitwise, so -0.0 is not taken for 0.0
+    bool is_constant(uint32_t id, Num value) const {
+        return is_constant(id) && std::memcmp(&nodes[id].value, &value, sizeof(Num)) == 0;
+    }
+
+    // Evaluates op on two constants; false when the result must stay a runtime error
+    static bool fold(Calc_Op op, Num a, Num b, Num& result) {
+        return calc_detail::apply(op, a, b, result) == Calc_Status::ok;
+    }
+
+    // Integer arithmetic can overflow, so only division by a constant other than 0 and -1 is known to succeed
+    bool can_fail(const Dag_Node<Num>& node) const {
+        if (!is_integer<Num>::value) return false;
+        if (node.op != Calc_Op::divide || !is_constant(node.right)) return true;
+        return nodes[node.right].value == Num(0) || nodes[node.right].value == Num(-1);
+    }
+
+public:
+    uint32_t intern(const Dag_Node<Num>& node) {
+        auto found = index.find(node);
+        if (found != index.end()) {
+            if (node.op != Calc_Op::push_constant && node.op != Calc_Op::load_variable) ++stats.shared;
+            return found->second;
+        }
+        uint32_t id = static_cast<uint32_t>(nodes.size());
+        bool fails = false;
+        if (node.op != Calc_Op::push_constant && node.op != Calc_Op::load_variable) {
+            fails = may_fail[node.left] || may_fail[node.right] || can_fail(node);
+        }
+        nodes.push_back(node);
+        may_fail.push_back(fails);
+        index.emplace(node, id);
+        return id;
+    }
+
+    uint32_t constant(Num value) {
+        return intern(Dag_Node<Num>{Calc_Op::push_constant, 0, 0, value});
+    }
+
+    uint32_t binary(Calc_Op op, uint32_t a, uint32_t b) {
+        Num result;
+        if (is_constant(a) && is_constant(b) && fold(op, nodes[a].value, nodes[b].value, result)) {
+            ++stats.folded;
+            return constant(result);
+        }
+        // x + 0 and x * 0 are only identities for integers: floating point has -0.0, NaN and infinity.
+        // Rewrites to 0 must not drop an operand whose evaluation can fail.
+        constexpr bool integral = is_integer<Num>::value;
+        const Num zero = Num(0);
+        const Num one = Num(1);
+        switch (op) {
+            case Calc_Op::add:
+                if (integral && is_constant(b, zero)) return identity(a);
+                if (integral && is_constant(a, zero)) return identity(b);
+                break;
+            case Calc_Op::subtract:
+                if (is_constant(b, zero)) return identity(a);
+                if (integral && a == b && !may_fail[a]) return identity(constant(zero));
+                break;
+            case Calc_Op::multiply:
+                if (is_constant(b, one)) return identity(a);
+                if (is_constant(a, one)) return identity(b);
+                if (integral && (is_constant(a, zero) || is_constant(b, zero)) && !may_fail[a] && !may_fail[b]) {
+                    return identity(constant(zero));
+                }
+                break;
+            case Calc_Op::divide:
+                if (is_constant(b, one)) return identity(a);
+                break;
+            default:
+                break;
+        }
+        if ((op == Calc_Op::add || op == Calc_Op::multiply) && a > b) {
+            std::swap(a, b);
+        }
+        return intern(Dag_Node<Num>{op, a, b, Num()});
+    }
+
+private:
+    uint32_t identity(uint32_t id) {
+        ++stats.identities;
+        return id;
+    }
+};
+
+} // namespace calc_detail
+
+/**
+ * @brief Optimize a compiled program
+ * @param program The program to optimize
+ * @param stats If not null, receives node counts and what was changed
+ * @return An equivalent program that evaluates the same variables in the same order. It fails
+ *         exactly when the original does, but if the original can fail in more than one place
+ *         the reordered program may report a different one of those errors.
+ */
+template <class Num>
+Calc_Program<Num> optimize(const Calc_Program<Num>& program, Calc_Optimize_Stats* stats = nullptr) {
+    using calc_detail::Dag_Node;
+    calc_detail::Dag_Builder<Num> builder;
+    builder.stats.nodes_before = program.instructions().size();
+    if (program.empty()) {
+        if (stats != nullptr) *stats = builder.stats;
+        return program;
+    }
+
+    // Build the DAG from the postfix code
+    std::vector<uint32_t> stack;
+    std::vector<uint32_t> local_nodes(program.locals());
+    for (const Calc_Instruction& instruction : program.instructions()) {
+        switch (instruction.op) {
+            case Calc_Op::push_constant:
+                stack.push_back(builder.constant(program.constant_pool()[instruction.operand]));
+                break;
+            case Calc_Op::load_variable:
+                stack.push_back(builder.intern(Dag_Node<Num>{Calc_Op::load_variable, instruction.operand, 0, Num()}));
+                break;
+            case Calc_Op::store_local:
+                local_nodes[instruction.operand] = stack.back();
+                break;
+            case Calc_Op::load_local:
+                stack.push_back(local_nodes[instruction.operand]);
+                break;
+            default: {
+                uint32_t right = stack.back();
+                stack.pop_back();
+                uint32_t left = stack.back();
+                stack.pop_back();
+                stack.push_back(builder.binary(instruction.op, left, right));
+                break;
+            }
+        }
+    }
+    const std::vector<Dag_Node<Num>>& nodes = builder.nodes;
+    const uint32_t root = stack.back();
+    auto is_leaf = [&](uint32_t id) {
+        return nodes[id].op == Calc_Op::push_constant || nodes[id].op == Calc_Op::load_variable;
+    };
+
+    // Count uses among the nodes reachable from the root
+    std::vector<uint32_t> uses(nodes.size(), 0);
+    std::vector<uint32_t> pending{root};
+    uses[root] = 1;
+    size_t reachable = 1;
+    while (!pending.empty()) {
+        uint32_t id = pending.back();
+        pending.pop_back();
+        if (is_leaf(id)) continue;
+        for (uint32_t child : {nodes[id].left, nodes[id].right}) {
+            if (uses[child]++ == 0) {
+                ++reachable;
+                pending.push_back(child);
+            }
+        }
+    }
+    builder.stats.nodes_after = reachable;
+
+    // Stack slots each subtree needs (Sethi-Ullman numbers); children always have smaller ids
+    std::vector<uint32_t> need(nodes.size(), 1);
+    for (uint32_t id = 0; id < nodes.size(); ++id) {
+        if (is_leaf(id)) continue;
+        uint32_t left = need[nodes[id].left];
+        uint32_t right = need[nodes[id].right];
+        bool commutative = nodes[id].op == Calc_Op::add || nodes[id].op == Calc_Op::multiply;
+        need[id] = commutative ? (left == right ? left + 1 : std::max(left, right)) : std::max(left, right + 1);
+    }
+    // Operands of + and * were put in canonical order for sharing; evaluate the deeper one first
+    auto first_child = [&](uint32_t id) {
+        const Dag_Node<Num>& node = nodes[id];
+        bool commutative = node.op == Calc_Op::add || node.op == Calc_Op::multiply;
+        return commutative && need[node.right] > need[node.left] ? node.right : node.left;
+    };
+    auto second_child = [&](uint32_t id) {
+        return first_child(id) == nodes[id].left ? nodes[id].right : nodes[id].left;
+    };
+
+    // Emit postfix code; shared inner nodes go to a local slot the first time
+    std::vector<Calc_Instruction> code;
+    std::vector<Num> constants;
+    std::unordered_map<uint32_t, uint32_t> constant_slots;
+    std::vector<uint32_t> local_slot(nodes.size(), UINT32_MAX);
+    uint32_t next_local = 0;
+    std::vector<std::pair<uint32_t, int>> frames{{root, 0}};
+    while (!frames.empty()) {
+        auto& frame = frames.back();
+        uint32_t id = frame.first;
+        const Dag_Node<Num>& node = nodes[id];
+        if (frame.second == 0) {
+            if (node.op == Calc_Op::push_constant) {
+                auto slot = constant_slots.emplace(id, static_cast<uint32_t>(constants.size()));
+                if (slot.second) constants.push_back(node.value);
+                code.push_back({Calc_Op::push_constant, slot.first->second});
+                frames.pop_back();
+            } else if (node.op == Calc_Op::load_variable) {
+                code.push_back({Calc_Op::load_variable, node.left});
+                frames.pop_back();
+            } else if (local_slot[id] != UINT32_MAX) {
+                code.push_back({Calc_Op::load_local, local_slot[id]});
+                frames.pop_back();
+            } else {
+                frame.second = 1;
+                frames.push_back({first_child(id), 0});
+            }
+        } else if (frame.second == 1) {
+            frame.second = 2;
+            frames.push_back({second_child(id), 0});
+        } else {
+            code.push_back({node.op, 0});
+            if (uses[id] > 1 && next_local < Calc_Program<Num>::max_locals) {
+                local_slot[id] = next_local++;
+                code.push_back({Calc_Op::store_local, local_slot[id]});
+            }
+            frames.pop_back();
+        }
+    }
+
+    if (stats != nullptr) *stats = builder.stats;
+    return Calc_Program<Num>(std::move(code), std::move(constants), program.variables());
+}
+
+#endif // CALC_OPTIMIZER_H
@@ -0,0 +1,683 @@
+/**
+ * @file Calc_Program.h
+ * @brief Compile Calc expressions once into bytecode and evaluate them on a fixed-size stack
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * compile() parses an infix expression (numbers, variables, + - * /, parentheses) with a
+ * single shunting-yard pass straight into postfix bytecode. evaluate() runs
+ * that bytecode on a stack array sized at compile time, so evaluating a
+ * program never touches the heap. The calc_compile() and calc_evaluate()
+ * forms report problems through Calc_Status instead of throwing.
+ *
+ * Numbers are read with std::from_chars, so floating-point programs accept
+ * decimals and exponents such as 2.5e3. Standard libraries without
+ * floating-point from_chars (Apple's libc++, for one) read them with strtod. Integer programs (including
+ * calc_int128 where the compiler has it) check every operation for overflow
+ * with the compiler's overflow builtins instead of wrapping silently.
+ */
+
+#ifndef CALC_PROGRAM_H
+#define CALC_PROGRAM_H
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <clocale>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Result of compiling or evaluating an expression
+ */
+enum class Calc_Status {
+    ok,
+    empty_expression,
+    unexpected_character,
+    missing_operand,
+    missing_operator,
+    unbalanced_parentheses,
+    number_out_of_range,
+    expression_too_deep,
+    division_by_zero,
+    unbound_variable,
+    overflow
+};
+
+/**
+ * @brief Describe a status in words
+ */
+inline const char* calc_status_message(Calc_Status status) noexcept {
+    switch (status) {
+        case Calc_Status::ok: return "ok";
+        case Calc_Status::empty_expression: return "empty expression";
+        case Calc_Status::unexpected_character: return "unexpected character";
+        case Calc_Status::missing_operand: return "missing operand";
+        case Calc_Status::missing_operator: return "missing operator";
+        case Calc_Status::unbalanced_parentheses: return "unbalanced parentheses";
+        case Calc_Status::number_out_of_range: return "number out of range";
+        case Calc_Status::expression_too_deep: return "expression too deep";
+        case Calc_Status::division_by_zero: return "division by zero";
+        case Calc_Status::unbound_variable: return "unbound variable";
+        case Calc_Status::overflow: return "arithmetic overflow";
+    }
+    return "unknown status";
+}
+
+/**
+ * @brief One bytecode operation
+ */
+enum class Calc_Op : uint8_t {
+    push_constant,
+    load_variable,
+    add,
+    subtract,
+    multiply,
+    divide,
+    store_local,
+    load_local
+};
+
+/**
+ * @brief One bytecode instruction
+ *
+ * operand indexes the constant pool for push_constant, the variable list for
+ * load_variable and a local slot for store_local and load_local; other
+ * operations ignore it. store_local copies the top of the stack into the slot
+ * without popping it, so a shared subexpression is computed once.
+ */
+struct Calc_Instruction {
+    Calc_Op op;
+    uint32_t operand;
+};
+
+#ifdef __SIZEOF_INT128__
+/// 128-bit signed integer for Calc_Program<calc_int128>, where the compiler provides one
+__extension__ typedef __int128 calc_int128;
+#endif
+
+namespace calc_detail {
+
+// std::is_integral is false for __int128 in strict ISO mode, so the number traits are spelled out.
+// bool is excluded: it has no arithmetic worth compiling for and the overflow builtins reject it.
+template <class Num>
+struct is_integer : std::integral_constant<bool, std::is_integral<Num>::value && !std::is_same<Num, bool>::value> {};
+
+#ifdef __SIZEOF_INT128__
+template <>
+struct is_integer<calc_int128> : std::true_type {};
+#endif
+
+template <class Num>
+struct is_number : std::integral_constant<bool, std::is_floating_point<Num>::value || is_integer<Num>::value> {};
+
+// The checked operations store the result and return true if it does not fit in Num.
+// Floating point never reports overflow; it has infinities for that.
+template <class Num>
+inline bool add_overflow(Num a, Num b, Num& result) noexcept {
+    if constexpr (is_integer<Num>::value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_add_overflow(a, b, &result);
+#else
+        if (b > 0 ? a > std::numeric_limits<Num>::max() - b : a < std::numeric_limits<Num>::min() - b) return true;
+#endif
+    }
+    result = a + b;
+    return false;
+}
+
+template <class Num>
+inline bool subtract_overflow(Num a, Num b, Num& result) noexcept {
+    if constexpr (is_integer<Num>::value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_sub_overflow(a, b, &result);
+#else
+        if (b < 0 ? a > std::numeric_limits<Num>::max() + b : a < std::numeric_limits<Num>::min() + b) return true;
+#endif
+    }
+    result = a - b;
+    return false;
+}
+
+template <class Num>
+inline bool multiply_overflow(Num a, Num b, Num& result) noexcept {
+    if constexpr (is_integer<Num>::value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_mul_overflow(a, b, &result);
+#else
+        const Num max = std::numeric_limits<Num>::max();
+        const Num min = std::numeric_limits<Num>::min();
+        if (a != 0 && b != 0 &&
+            (a > 0 ? (b > 0 ? a > max / b : b < min / a) : (b > 0 ? a < min / b : b < max / a))) {
+            return true;
+        }
+#endif
+    }
+    result = a * b;
+    return false;
+}
+
+// The caller has already ruled out an integer divisor of zero
+template <class Num>
+inline bool divide_overflow(Num a, Num b, Num& result) noexcept {
+    if constexpr (is_integer<Num>::value) {
+        // Only the most negative value divided by -1 overflows, exactly when negating it does
+        if (!std::is_unsigned<Num>::value && b == Num(-1)) return subtract_overflow(Num(0), a, result);
+    }
+    result = a / b;
+    return false;
+}
+
+} // namespace calc_detail
+
+template <class Num = long>
+class Calc_Program;
+
+template <class Num>
+Calc_Status calc_compile(std::string_view source, Calc_Program<Num>& program, std::vector<char>& operators,
+                         size_t* error_pos = nullptr);
+
+/**
+ * @brief A compiled expression: postfix bytecode plus its constant pool
+ * @tparam Num The arithmetic type the expression is evaluated in
+ */
+template <class Num>
+class Calc_Program {
+private:
+    std::vector<Calc_Instruction> code;
+    std::vector<Num> constants;
+    std::vector<std::string> names;
+    size_t depth;
+    size_t local_count;
+
+    friend Calc_Status calc_compile<Num>(std::string_view source, Calc_Program& program, std::vector<char>& operators,
+                                         size_t* error_pos);
+
+public:
+    static_assert(calc_detail::is_number<Num>::value, "Calc_Program needs an integer or floating-point number type");
+
+    /// Deepest operand stack a program may need; evaluation keeps a stack array this large
+    static constexpr size_t max_depth = 256;
+
+    /// Most local slots a program may use
+    static constexpr size_t max_locals = 256;
+
+    /**
+     * @brief Construct an empty program; evaluating it fails with empty_expression
+     */
+    Calc_Program() noexcept : depth(0), local_count(0) {}
+
+    /**
+     * @brief Assemble a program from bytecode, for example the output of an optimizer
+     * @param code The instructions
+     * @param constants The constant pool
+     * @param names The variable names
+     * @throw std::invalid_argument if the code reads outside the pools, loads a local
+     *        before storing it, leaves other than one value on the stack or is too deep
+     */
+    Calc_Program(std::vector<Calc_Instruction> code, std::vector<Num> constants, std::vector<std::string> names)
+        : code(std::move(code)), constants(std::move(constants)), names(std::move(names)), depth(0), local_count(0) {
+        std::vector<bool> stored;
+        size_t top = 0;
+        for (const Calc_Instruction& instruction : this->code) {
+            bool valid = true;
+            switch (instruction.op) {
+                case Calc_Op::push_constant:
+                    valid = instruction.operand < this->constants.size();
+                    ++top;
+                    break;
+                case Calc_Op::load_variable:
+                    valid = instruction.operand < this->names.size();
+                    ++top;
+                    break;
+                case Calc_Op::load_local:
+                    valid = instruction.operand < stored.size() && stored[instruction.operand];
+                    ++top;
+                    break;
+                case Calc_Op::store_local:
+                    valid = top >= 1 && instruction.operand < max_locals;
+                    if (valid && instruction.operand >= stored.size()) stored.resize(instruction.operand + 1, false);
+                    if (valid) stored[instruction.operand] = true;
+                    break;
+                default:
+                    valid = top >= 2;
+                    top -= valid ? 1 : 0;
+                    break;
+            }
+            if (!valid || top > max_depth) {
+                throw std::invalid_argument("Malformed Calc_Program bytecode");
+            }
+            depth = std::max(depth, top);
+        }
+        if (!this->code.empty() && top != 1) {
+            throw std::invalid_argument("Malformed Calc_Program bytecode");
+        }
+        local_count = stored.size();
+    }
+
+    [[nodiscard]] const std::vector<Calc_Instruction>& instructions() const noexcept {
+        return code;
+    }
+
+    [[nodiscard]] const std::vector<Num>& constant_pool() const noexcept {
+        return constants;
+    }
+
+    /**
+     * @brief Get the variable names in the order their values are passed to evaluate()
+     */
+    [[nodiscard]] const std::vector<std::string>& variables() const noexcept {
+        return names;
+    }
+
+    /**
+     * @brief Find a variable's position in variables()
+     * @param name The variable name
+     * @return Its index, or size_t(-1) if the expression does not use it
+     */
+    [[nodiscard]] size_t variable_index(std::string_view name) const noexcept {
+        for (size_t i = 0; i < names.size(); ++i) {
+            if (names[i] == name) return i;
+        }
+        return static_cast<size_t>(-1);
+    }
+
+    /**
+     * @brief Get the deepest operand stack the program reaches
+     */
+    [[nodiscard]] size_t stack_depth() const noexcept {
+        return depth;
+    }
+
+    /**
+     * @brief Get the number of local slots the program uses
+     */
+    [[nodiscard]] size_t locals() const noexcept {
+        return local_count;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return code.empty();
+    }
+};
+
+namespace calc_detail {
+
+inline bool is_digit(char c) noexcept {
+    return c >= '0' && c <= '9';
+}
+
+inline bool is_identifier_start(char c) noexcept {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+inline bool is_identifier_char(char c) noexcept {
+    return is_identifier_start(c) || is_digit(c);
+}
+
+inline bool is_space(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+inline int precedence(char op) noexcept {
+    return (op == '*' || op == '/') ? 2 : 1;
+}
+
+inline Calc_Op to_op(char op) noexcept {
+    switch (op) {
+        case '+': return Calc_Op::add;
+        case '-': return Calc_Op::subtract;
+        case '*': return Calc_Op::multiply;
+        default: return Calc_Op::divide;
+    }
+}
+
+// Whether the standard library has from_chars and to_chars for floating-point
+// types; define CALC_NO_FLOAT_CHARCONV to use the C library fallback anyway
+#if defined(__cpp_lib_to_chars) && !defined(CALC_NO_FLOAT_CHARCONV)
+constexpr bool float_charconv = true;
+#else
+constexpr bool float_charconv = false;
+#endif
+
+// The decimal point strtod and printf use, which is '.' unless the program
+// has changed LC_NUMERIC
+inline char locale_decimal_point() noexcept {
+    const char* point = std::localeconv()->decimal_point;
+    return point != nullptr && point[0] != '\0' ? point[0] : '.';
+}
+
+// Reads a floating-point number the way from_chars does (digits, an optional
+// fraction and an optional exponent) with strtod on a copy of the token.
+// Returns the end of the number, or nullptr with status set on failure.
+template <class Num>
+const char* parse_float(const char* first, const char* last, Num& value, Calc_Status& status) noexcept {
+    auto digits = [last](const char* position) {
+        while (position != last && is_digit(*position)) ++position;
+        return position;
+    };
+    const char* end = digits(first);
+    bool any_digit = end != first;
+    if (end != last && *end == '.') {
+        const char* fraction = digits(end + 1);
+        any_digit = any_digit || fraction != end + 1;
+        end = fraction;
+    }
+    if (!any_digit) {
+        status = Calc_Status::unexpected_character;
+        return nullptr;
+    }
+    if (end != last && (*end == 'e' || *end == 'E')) {
+        const char* exponent = end + 1;
+        if (exponent != last && (*exponent == '+' || *exponent == '-')) ++exponent;
+        if (exponent != last && is_digit(*exponent)) end = digits(exponent);
+    }
+    // Longer tokens than this are only ever padding with zeros
+    char token[512];
+    size_t length = static_cast<size_t>(end - first);
+    if (length >= sizeof(token)) {
+        status = Calc_Status::number_out_of_range;
+        return nullptr;
+    }
+    std::memcpy(token, first, length);
+    token[length] = '\0';
+    char point = locale_decimal_point();
+    if (point != '.') std::replace(token, token + length, '.', point);
+    char* parsed = nullptr;
+    int saved_errno = errno;
+    errno = 0;
+    if constexpr (std::is_same<Num, float>::value) {
+        value = std::strtof(token, &parsed);
+    } else if constexpr (std::is_same<Num, double>::value) {
+        value = std::strtod(token, &parsed);
+    } else {
+        value = static_cast<Num>(std::strtold(token, &parsed));
+    }
+    bool out_of_range = errno == ERANGE;
+    errno = saved_errno;
+    if (parsed != token + length) {
+        status = Calc_Status::unexpected_character;
+        return nullptr;
+    }
+    if (out_of_range) {
+        status = Calc_Status::number_out_of_range;
+        return nullptr;
+    }
+    status = Calc_Status::ok;
+    return end;
+}
+
+// Reads the number starting at source[i] and moves i past it. Integers take
+// decimal digits only; floating types also take a fraction and an exponent.
+template <class Num>
+Calc_Status parse_number(std::string_view source, size_t& i, Num& value) noexcept {
+    const char* first = source.data() + i;
+    const char* last = source.data() + source.size();
+    const char* end = first;
+    if constexpr (std::is_integral<Num>::value || (std::is_floating_point<Num>::value && float_charconv)) {
+        std::from_chars_result parsed = std::from_chars(first, last, value);
+        if (parsed.ec == std::errc::result_out_of_range) return Calc_Status::number_out_of_range;
+        if (parsed.ec != std::errc()) return Calc_Status::unexpected_character;
+        end = parsed.ptr;
+    } else if constexpr (std::is_floating_point<Num>::value) {
+        Calc_Status status = Calc_Status::ok;
+        end = parse_float(first, last, value, status);
+        if (end == nullptr) return status;
+    } else {
+        // No from_chars for __int128 in strict ISO mode
+        value = 0;
+        for (; end != last && is_digit(*end); ++end) {
+            if (multiply_overflow(value, Num(10), value) || add_overflow(value, Num(*end - '0'), value)) {
+                return Calc_Status::number_out_of_range;
+            }
+        }
+        if (end == first) return Calc_Status::unexpected_character;
+    }
+    i += static_cast<size_t>(end - first);
+    return Calc_Status::ok;
+}
+
+// Runs one binary operation, reporting integer division by zero and overflow
+template <class Num>
+Calc_Status apply(Calc_Op op, Num a, Num b, Num& result) noexcept {
+    bool overflow = false;
+    switch (op) {
+        case Calc_Op::add: overflow = add_overflow(a, b, result); break;
+        case Calc_Op::subtract: overflow = subtract_overflow(a, b, result); break;
+        case Calc_Op::multiply: overflow = multiply_overflow(a, b, result); break;
+        case Calc_Op::divide:
+            if (is_integer<Num>::value && b == Num(0)) return Calc_Status::division_by_zero;
+            overflow = divide_overflow(a, b, result);
+            break;
+        default: return Calc_Status::unexpected_character;
+    }
+    return overflow ? Calc_Status::overflow : Calc_Status::ok;
+}
+
+} // namespace calc_detail
+
+/**
+ * @brief Compile an infix expression into a program without throwing
+ *
+ * Recompiling into the same program with the same operator scratch reuses
+ * their storage, so a loop over many expressions stops allocating once the
+ * buffers have grown to fit.
+ *
+ * @param source The expression text
+ * @param program Receives the compiled program; left empty on failure
+ * @param operators Scratch space for the operator stack
+ * @param error_pos If not null, receives the offset of the problem on failure
+ * @return Calc_Status::ok or the reason compilation failed
+ */
+template <class Num>
+Calc_Status calc_compile(std::string_view source, Calc_Program<Num>& program, std::vector<char>& operators,
+                         size_t* error_pos) {
+    program.code.clear();
+    program.constants.clear();
+    program.names.clear();
+    program.depth = 0;
+    program.local_count = 0;
+    operators.clear();
+
+    size_t depth = 0;
+    bool expect_operand = true;
+    size_t i = 0;
+
+    auto fail = [&](Calc_Status status, size_t pos) {
+        program.code.clear();
+        program.constants.clear();
+        program.names.clear();
+        program.depth = 0;
+        if (error_pos != nullptr) *error_pos = pos;
+        return status;
+    };
+    auto emit = [&](char op) {
+        program.code.push_back({calc_detail::to_op(op), 0});
+        --depth;
+    };
+
+    while (i < source.size()) {
+        char c = source[i];
+        if (calc_detail::is_space(c)) {
+            ++i;
+        } else if (calc_detail::is_digit(c) || (c == '.' && !calc_detail::is_integer<Num>::value)) {
+            if (!expect_operand) return fail(Calc_Status::missing_operator, i);
+            size_t start = i;
+            Num value{};
+            Calc_Status parsed = calc_detail::parse_number(source, i, value);
+            if (parsed != Calc_Status::ok) return fail(parsed, start);
+            if (++depth > Calc_Program<Num>::max_depth) return fail(Calc_Status::expression_too_deep, start);
+            program.code.push_back({Calc_Op::push_constant, static_cast<uint32_t>(program.constants.size())});
+            program.constants.push_back(value);
+            if (depth > program.depth) program.depth = depth;
+            expect_operand = false;
+        } else if (calc_detail::is_identifier_start(c)) {
+            if (!expect_operand) return fail(Calc_Status::missing_operator, i);
+            size_t start = i;
+            while (i < source.size() && calc_detail::is_identifier_char(source[i])) ++i;
+            std::string_view name = source.substr(start, i - start);
+            size_t index = program.variable_index(name);
+            if (index == static_cast<size_t>(-1)) {
+                index = program.names.size();
+                program.names.emplace_back(name);
+            }
+            if (++depth > Calc_Program<Num>::max_depth) return fail(Calc_Status::expression_too_deep, start);
+            program.code.push_back({Calc_Op::load_variable, static_cast<uint32_t>(index)});
+            if (depth > program.depth) program.depth = depth;
+            expect_operand = false;
+        } else if (c == '(') {
+            if (!expect_operand) return fail(Calc_Status::missing_operator, i);
+            operators.push_back(c);
+            ++i;
+        } else if (c == ')') {
+            if (expect_operand) return fail(Calc_Status::missing_operand, i);
+            while (!operators.empty() && operators.back() != '(') {
+                emit(operators.back());
+                operators.pop_back();
+            }
+            if (operators.empty()) return fail(Calc_Status::unbalanced_parentheses, i);
+            operators.pop_back();
+            ++i;
+        } else if (c == '+' || c == '-' || c == '*' || c == '/') {
+            if (expect_operand) return fail(Calc_Status::missing_operand, i);
+            while (!operators.empty() && operators.back() != '(' &&
+                   calc_detail::precedence(operators.back()) >= calc_detail::precedence(c)) {
+                emit(operators.back());
+                operators.pop_back();
+            }
+            operators.push_back(c);
+            expect_operand = true;
+            ++i;
+        } else {
+            return fail(Calc_Status::unexpected_character, i);
+        }
+    }
+
+    if (program.code.empty()) return fail(Calc_Status::empty_expression, 0);
+    if (expect_operand) return fail(Calc_Status::missing_operand, source.size());
+    while (!operators.empty()) {
+        if (operators.back() == '(') return fail(Calc_Status::unbalanced_parentheses, source.size());
+        emit(operators.back());
+        operators.pop_back();
+    }
+    return Calc_Status::ok;
+}
+
+/**
+ * @brief Compile an infix expression into a program without throwing
+ * @param source The expression text
+ * @param program Receives the compiled program; left empty on failure
+ * @param error_pos If not null, receives the offset of the problem on failure
+ * @return Calc_Status::ok or the reason compilation failed
+ */
+template <class Num>
+Calc_Status calc_compile(std::string_view source, Calc_Program<Num>& program, size_t* error_pos = nullptr) {
+    std::vector<char> operators;
+    return calc_compile(source, program, operators, error_pos);
+}
+
+/**
+ * @brief Compile an infix expression into a program
+ * @param source The expression text
+ * @return The compiled program
+ * @throw std::invalid_argument if the expression is malformed
+ */
+template <class Num = long>
+Calc_Program<Num> compile(std::string_view source) {
+    Calc_Program<Num> program;
+    size_t pos = 0;
+    Calc_Status status = calc_compile(source, program, &pos);
+    if (status != Calc_Status::ok) {
+        throw std::invalid_argument(std::string("Cannot compile expression: ") + calc_status_message(status) +
+                                    " at offset " + std::to_string(pos));
+    }
+    return program;
+}
+
+/**
+ * @brief Evaluate a compiled program without throwing or allocating
+ * @param program The program to run
+ * @param result Receives the value on success
+ * @param values One value per entry of program.variables(), or nullptr if it has none
+ * @return Calc_Status::ok, empty_expression, unbound_variable, division_by_zero or overflow
+ */
+template <class Num>
+Calc_Status calc_evaluate(const Calc_Program<Num>& program, Num& result, const Num* values = nullptr) noexcept {
+    if (program.empty()) return Calc_Status::empty_expression;
+    if (values == nullptr && !program.variables().empty()) return Calc_Status::unbound_variable;
+
+    Num stack[Calc_Program<Num>::max_depth];
+    Num locals[Calc_Program<Num>::max_locals];
+    size_t top = 0;
+    const Num* constants = program.constant_pool().data();
+    for (const Calc_Instruction& instruction : program.instructions()) {
+        switch (instruction.op) {
+            case Calc_Op::push_constant:
+                stack[top++] = constants[instruction.operand];
+                break;
+            case Calc_Op::load_variable:
+                stack[top++] = values[instruction.operand];
+                break;
+            case Calc_Op::store_local:
+                locals[instruction.operand] = stack[top - 1];
+                break;
+            case Calc_Op::load_local:
+                stack[top++] = locals[instruction.operand];
+                break;
+            case Calc_Op::add:
+                --top;
+                if (calc_detail::add_overflow(stack[top - 1], stack[top], stack[top - 1])) return Calc_Status::overflow;
+                break;
+            case Calc_Op::subtract:
+                --top;
+                if (calc_detail::subtract_overflow(stack[top - 1], stack[top], stack[top - 1])) {
+                    return Calc_Status::overflow;
+                }
+                break;
+            case Calc_Op::multiply:
+                --top;
+                if (calc_detail::multiply_overflow(stack[top - 1], stack[top], stack[top - 1])) {
+                    return Calc_Status::overflow;
+                }
+                break;
+            case Calc_Op::divide:
+                --top;
+                if (calc_detail::is_integer<Num>::value && stack[top] == Num(0)) return Calc_Status::division_by_zero;
+                if (calc_detail::divide_overflow(stack[top - 1], stack[top], stack[top - 1])) {
+                    return Calc_Status::overflow;
+                }
+                break;
+        }
+    }
+    result = stack[0];
+    return Calc_Status::ok;
+}
+
+/**
+ * @brief Evaluate a compiled program
+ * @param program The program to run
+ * @param values One value per entry of program.variables(), or nullptr if it has none
+ * @return The value of the expression
+ * @throw std::runtime_error on division by zero, overflow, missing variable values or an empty program
+ */
+template <class Num>
+Num evaluate(const Calc_Program<Num>& program, const Num* values = nullptr) {
+    Num result{};
+    Calc_Status status = calc_evaluate(program, result, values);
+    if (status != Calc_Status::ok) {
+        throw std::runtime_error(std::string("Cannot evaluate expression: ") + calc_status_message(status));
+    }
+    return result;
+}
+
+#endif // CALC_PROGRAM_H
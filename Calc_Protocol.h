@@ -0,0 +1,266 @@
+/**
+ * @file Calc_Protocol.h
+ * @brief Length-prefixed binary messages for evaluating Calc batches over a local socket, and a blocking client
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * Every message is a frame: a 32-bit payload length followed by the payload.
+ * A request payload is a 32-bit expression count followed by each expression
+ * as a 32-bit length and its bytes. A reply payload is a 32-bit count, one
+ * status byte per expression and then the values as a packed Num array.
+ * Both ends live on the same host, so integers use the native byte order and
+ * the value array can be copied straight in and out.
+ */
+
+#ifndef CALC_PROTOCOL_H
+#define CALC_PROTOCOL_H
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Calc_Program.h"
+
+/// Largest payload either side accepts; a longer frame means a broken peer
+constexpr size_t calc_max_frame_bytes = size_t(64) << 20;
+
+/**
+ * @brief What calc_next_frame() found at the front of a buffer
+ */
+enum class Calc_Frame {
+    complete,
+    incomplete,
+    too_large
+};
+
+namespace calc_detail {
+
+inline void put_u32(std::string& out, uint32_t value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+inline bool get_u32(std::string_view& in, uint32_t& value) {
+    if (in.size() < sizeof(value)) return false;
+    std::memcpy(&value, in.data(), sizeof(value));
+    in.remove_prefix(sizeof(value));
+    return true;
+}
+
+// Starts a frame in out and returns where its length goes once the payload is written
+inline size_t begin_frame(std::string& out) {
+    size_t start = out.size();
+    put_u32(out, 0);
+    return start;
+}
+
+inline void end_frame(std::string& out, size_t start) {
+    uint32_t length = static_cast<uint32_t>(out.size() - start - sizeof(uint32_t));
+    std::memcpy(&out[start], &length, sizeof(length));
+}
+
+inline sockaddr_un socket_address(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Unix socket path must be 1 to " + std::to_string(sizeof(address.sun_path) - 1) +
+                                    " bytes: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+} // namespace calc_detail
+
+/**
+ * @brief Find the first whole frame in a buffer of received bytes
+ * @param buffer Bytes received so far
+ * @param payload Receives the payload of the first frame when it is complete
+ * @param consumed Receives the size of that frame, length prefix included
+ * @return complete, incomplete if more bytes are needed, or too_large
+ */
+inline Calc_Frame calc_next_frame(std::string_view buffer, std::string_view& payload, size_t& consumed) {
+    uint32_t length = 0;
+    if (!calc_detail::get_u32(buffer, length)) return Calc_Frame::incomplete;
+    if (length > calc_max_frame_bytes) return Calc_Frame::too_large;
+    if (buffer.size() < length) return Calc_Frame::incomplete;
+    payload = buffer.substr(0, length);
+    consumed = sizeof(uint32_t) + length;
+    return Calc_Frame::complete;
+}
+
+/**
+ * @brief Append a request frame for a batch of expressions
+ * @param expressions Pointer to the first expression
+ * @param count Number of expressions
+ * @param out The buffer to append to
+ */
+inline void calc_encode_request(const std::string_view* expressions, size_t count, std::string& out) {
+    size_t start = calc_detail::begin_frame(out);
+    calc_detail::put_u32(out, static_cast<uint32_t>(count));
+    for (size_t i = 0; i < count; ++i) {
+        calc_detail::put_u32(out, static_cast<uint32_t>(expressions[i].size()));
+        out.append(expressions[i].data(), expressions[i].size());
+    }
+    calc_detail::end_frame(out, start);
+}
+
+/**
+ * @brief Read the expressions of a request payload without copying them
+ * @param payload A request payload from calc_next_frame()
+ * @param expressions Receives views into payload
+ * @return false if the payload is malformed
+ */
+inline bool calc_decode_request(std::string_view payload, std::vector<std::string_view>& expressions) {
+    uint32_t count = 0;
+    expressions.clear();
+    if (!calc_detail::get_u32(payload, count) || count > payload.size() / sizeof(uint32_t)) return false;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t length = 0;
+        if (!calc_detail::get_u32(payload, length) || length > payload.size()) return false;
+        expressions.push_back(payload.substr(0, length));
+        payload.remove_prefix(length);
+    }
+    return payload.empty();
+}
+
+/**
+ * @brief Append a reply frame for an evaluated batch
+ * @param values One value per expression
+ * @param statuses One status per expression
+ * @param count Number of expressions
+ * @param out The buffer to append to
+ */
+template <class Num>
+void calc_encode_reply(const Num* values, const Calc_Status* statuses, size_t count, std::string& out) {
+    size_t start = calc_detail::begin_frame(out);
+    calc_detail::put_u32(out, static_cast<uint32_t>(count));
+    for (size_t i = 0; i < count; ++i) {
+        out.push_back(static_cast<char>(statuses[i]));
+    }
+    out.append(reinterpret_cast<const char*>(values), count * sizeof(Num));
+    calc_detail::end_frame(out, start);
+}
+
+/**
+ * @brief Read the results of a reply payload
+ * @param payload A reply payload from calc_next_frame()
+ * @param values Receives one value per expression
+ * @param statuses Receives one status per expression
+ * @return false if the payload is malformed
+ */
+template <class Num>
+bool calc_decode_reply(std::string_view payload, std::vector<Num>& values, std::vector<Calc_Status>& statuses) {
+    uint32_t count = 0;
+    if (!calc_detail::get_u32(payload, count) || payload.size() != count * (1 + sizeof(Num))) return false;
+    statuses.resize(count);
+    values.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint8_t status = static_cast<uint8_t>(payload[i]);
+        if (status > static_cast<uint8_t>(Calc_Status::overflow)) return false;
+        statuses[i] = static_cast<Calc_Status>(status);
+    }
+    if (count > 0) std::memcpy(values.data(), payload.data() + count, count * sizeof(Num));
+    return true;
+}
+
+/**
+ * @brief A blocking connection to a Calc_Server
+ * @tparam Num The number type the server evaluates in
+ */
+template <class Num = long>
+class Calc_Client {
+private:
+    int fd;
+    std::string outgoing;
+    std::string incoming;
+
+public:
+    /**
+     * @brief Connect to a server's socket
+     * @param path The Unix domain socket path the server listens on
+     * @throw std::system_error if the connection fails
+     */
+    explicit Calc_Client(const std::string& path) : fd(::socket(AF_UNIX, SOCK_STREAM, 0)) {
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot create socket");
+        }
+        sockaddr_un address = calc_detail::socket_address(path);
+        if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "Cannot connect to " + path);
+        }
+    }
+
+    Calc_Client(const Calc_Client&) = delete;
+    Calc_Client& operator=(const Calc_Client&) = delete;
+
+    ~Calc_Client() {
+        ::close(fd);
+    }
+
+    /**
+     * @brief Send one batch and wait for its results
+     * @param expressions Pointer to the first expression
+     * @param count Number of expressions
+     * @param values Receives one value per expression; failed ones get Num()
+     * @param statuses Receives one status per expression
+     * @throw std::system_error if the connection fails
+     * @throw std::runtime_error if the server closes the connection or replies with a malformed frame
+     */
+    void evaluate(const std::string_view* expressions, size_t count, std::vector<Num>& values,
+                  std::vector<Calc_Status>& statuses) {
+        outgoing.clear();
+        calc_encode_request(expressions, count, outgoing);
+        for (size_t sent = 0; sent < outgoing.size();) {
+#ifdef MSG_NOSIGNAL
+            ssize_t written = ::send(fd, outgoing.data() + sent, outgoing.size() - sent, MSG_NOSIGNAL);
+#else
+            ssize_t written = ::send(fd, outgoing.data() + sent, outgoing.size() - sent, 0);
+#endif
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw std::system_error(errno, std::generic_category(), "Cannot send Calc request");
+            }
+            sent += static_cast<size_t>(written);
+        }
+
+        incoming.clear();
+        std::string_view payload;
+        size_t consumed = 0;
+        char chunk[65536];
+        for (;;) {
+            Calc_Frame frame = calc_next_frame(incoming, payload, consumed);
+            if (frame == Calc_Frame::complete) break;
+            if (frame == Calc_Frame::too_large) throw std::runtime_error("Calc reply frame too large");
+            ssize_t received = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (received < 0) {
+                if (errno == EINTR) continue;
+                throw std::system_error(errno, std::generic_category(), "Cannot receive Calc reply");
+            }
+            if (received == 0) throw std::runtime_error("Calc server closed the connection");
+            incoming.append(chunk, static_cast<size_t>(received));
+        }
+        if (!calc_decode_reply(payload, values, statuses) || values.size() != count) {
+            throw std::runtime_error("Malformed Calc reply");
+        }
+    }
+};
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+#endif // CALC_PROTOCOL_H
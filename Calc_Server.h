@@ -0,0 +1,464 @@
+/**
+ * @file Calc_Server.h
+ * @brief A local daemon evaluating Calc batches over a Unix domain socket with epoll
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * Processes on one host send batches of expressions framed as described in
+ * Calc_Protocol.h and get one reply frame per batch. Each event-loop thread
+ * has its own epoll set and accepts from the shared listening socket, and all
+ * of them compile through one Sharded_Calc_Cache, so an expression parsed for
+ * one client is a cache hit for every other. A client that stops reading its
+ * replies stops being read once a megabyte of them is waiting, and a loop
+ * that runs out of descriptors stops accepting for a moment instead of
+ * spinning on the listening socket. A connection that cannot be served is
+ * closed; a loop that fails stops the server and run() rethrows its error.
+ * Linux only.
+ */
+
+#ifndef CALC_SERVER_H
+#define CALC_SERVER_H
+
+#if defined(__linux__)
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Calc_Cache.h"
+#include "Calc_Protocol.h"
+
+/**
+ * @brief Counters describing what a server has handled
+ */
+struct Calc_Server_Stats {
+    size_t connections = 0;
+    size_t batches = 0;
+    size_t expressions = 0;
+    size_t errors = 0;
+    size_t accept_failures = 0;
+};
+
+/**
+ * @brief An epoll server answering Calc batches on a Unix domain socket
+ * @tparam Num The number type expressions are evaluated in
+ */
+template <class Num = long>
+class Calc_Server {
+private:
+    struct Connection {
+        int fd;
+        std::string input;
+        std::string output;
+        size_t sent = 0;
+        uint32_t events = EPOLLIN;
+    };
+
+    // Per-loop buffers reused for every batch
+    struct Scratch {
+        std::vector<std::string_view> expressions;
+        std::vector<Num> values;
+        std::vector<Calc_Status> statuses;
+    };
+
+    std::string path;
+    int listen_fd;
+    int wake_fd;
+    size_t loops;
+    Sharded_Calc_Cache<Num> cache;
+    std::atomic<size_t> connection_count;
+    std::atomic<size_t> batch_count;
+    std::atomic<size_t> expression_count;
+    std::atomic<size_t> error_count;
+    std::atomic<size_t> accept_failure_count;
+    // The first exception a loop ended with, rethrown by run()
+    std::mutex error_mutex;
+    std::exception_ptr loop_error;
+
+    // Replies a connection may have waiting before its requests stop being read
+    static constexpr size_t max_pending_output = size_t(1) << 20;
+    // How long a loop stops accepting after running out of descriptors or memory
+    static constexpr std::chrono::milliseconds accept_backoff{100};
+
+    static bool try_add(int epoll_fd, int fd, uint32_t events, void* tag) noexcept {
+        epoll_event event{};
+        event.events = events;
+        event.data.ptr = tag;
+        return ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+    }
+
+    static void add(int epoll_fd, int fd, uint32_t events, void* tag) {
+        if (!try_add(epoll_fd, fd, events, tag)) {
+            throw std::system_error(errno, std::generic_category(), "Cannot add descriptor to epoll");
+        }
+    }
+
+    Calc_Status evaluate_one(std::string_view expression, Num& value) {
+        value = Num();
+        try {
+            typename Sharded_Calc_Cache<Num>::Program_Ptr program = cache.get(expression);
+            Calc_Status status = calc_evaluate(*program, value);
+            if (status != Calc_Status::ok) value = Num();
+            return status;
+        } catch (const std::invalid_argument&) {
+            // Failures are not cached; compile again only to learn why
+            Calc_Program<Num> program;
+            return calc_compile(expression, program);
+        }
+    }
+
+    // Answers whole frames in the input until the output is full, which sets
+    // stalled; false if the client sent garbage
+    bool handle_input(Connection& connection, Scratch& scratch, bool& stalled) {
+        std::string_view pending(connection.input);
+        std::string_view payload;
+        size_t consumed = 0;
+        Calc_Frame frame = Calc_Frame::incomplete;
+        stalled = false;
+        for (;;) {
+            if (connection.output.size() >= max_pending_output) {
+                stalled = true;
+                break;
+            }
+            frame = calc_next_frame(pending, payload, consumed);
+            if (frame != Calc_Frame::complete) break;
+            if (!calc_decode_request(payload, scratch.expressions)) return false;
+            size_t count = scratch.expressions.size();
+            scratch.values.resize(count);
+            scratch.statuses.resize(count);
+            size_t failed = 0;
+            for (size_t i = 0; i < count; ++i) {
+                scratch.statuses[i] = evaluate_one(scratch.expressions[i], scratch.values[i]);
+                failed += scratch.statuses[i] != Calc_Status::ok;
+            }
+            calc_encode_reply(scratch.values.data(), scratch.statuses.data(), count, connection.output);
+            batch_count.fetch_add(1, std::memory_order_relaxed);
+            expression_count.fetch_add(count, std::memory_order_relaxed);
+            error_count.fetch_add(failed, std::memory_order_relaxed);
+            pending.remove_prefix(consumed);
+        }
+        connection.input.erase(0, connection.input.size() - pending.size());
+        return frame != Calc_Frame::too_large;
+    }
+
+    // Sends what the socket takes now, watches for writability if some is left
+    // and for readability only while the output is below the cap
+    bool flush(int epoll_fd, Connection& connection) {
+        while (connection.sent < connection.output.size()) {
+            ssize_t written = ::send(connection.fd, connection.output.data() + connection.sent,
+                                     connection.output.size() - connection.sent, MSG_NOSIGNAL);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                return false;
+            }
+            connection.sent += static_cast<size_t>(written);
+        }
+        if (connection.sent == connection.output.size()) {
+            connection.output.clear();
+            connection.sent = 0;
+        }
+        uint32_t wanted = (connection.output.size() < max_pending_output ? EPOLLIN : 0u) |
+                          (connection.output.empty() ? 0u : EPOLLOUT);
+        if (wanted != connection.events) {
+            epoll_event event{};
+            event.events = wanted;
+            event.data.ptr = &connection;
+            ::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, connection.fd, &event);
+            connection.events = wanted;
+        }
+        return true;
+    }
+
+    // Reads what is available, up to the output cap per call so a fast sender
+    // cannot grow the input without bound; false once the connection should close
+    bool receive(Connection& connection) {
+        char chunk[65536];
+        for (size_t taken = 0; taken < max_pending_output; taken += sizeof(chunk)) {
+            ssize_t received = ::recv(connection.fd, chunk, sizeof(chunk), 0);
+            if (received > 0) {
+                connection.input.append(chunk, static_cast<size_t>(received));
+                continue;
+            }
+            if (received == 0) return false;
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        // Level-triggered, so epoll reports whatever is left next time
+        return true;
+    }
+
+    bool watch_listener(int epoll_fd) noexcept {
+        // The listening socket is tagged with nullptr
+#ifdef EPOLLEXCLUSIVE
+        return try_add(epoll_fd, listen_fd, EPOLLIN | EPOLLEXCLUSIVE, nullptr);
+#else
+        return try_add(epoll_fd, listen_fd, EPOLLIN, nullptr);
+#endif
+    }
+
+    // False when the process is out of descriptors or memory, or epoll cannot
+    // watch another connection; the listening socket stays readable then, so
+    // the caller has to stop watching it
+    bool accept_all(int epoll_fd, std::unordered_map<Connection*, std::unique_ptr<Connection>>& connections) {
+        for (;;) {
+            int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) continue;
+                if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+                    accept_failure_count.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                // EAGAIN: another loop took it or the backlog is empty
+                return true;
+            }
+            std::unique_ptr<Connection> connection;
+            bool watched = false;
+            try {
+                connection.reset(new Connection{fd, {}, {}, 0, EPOLLIN});
+                watched = try_add(epoll_fd, fd, EPOLLIN, connection.get());
+                if (watched) connections.emplace(connection.get(), std::move(connection));
+            } catch (const std::bad_alloc&) {
+                watched = false;
+            }
+            if (!watched) {
+                // Closing the descriptor also takes it out of the epoll set
+                ::close(fd);
+                accept_failure_count.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            connection_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // Runs one event loop until stop(). Nothing escapes a loop thread: an
+    // error is kept for run() and stops the other loops.
+    void loop() noexcept {
+        int epoll_fd = -1;
+        std::unordered_map<Connection*, std::unique_ptr<Connection>> connections;
+        try {
+            epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+            if (epoll_fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "Cannot create epoll instance");
+            }
+            serve(epoll_fd, connections);
+        } catch (...) {
+            fail(std::current_exception());
+        }
+        for (auto& entry : connections) {
+            ::close(entry.second->fd);
+        }
+        if (epoll_fd >= 0) ::close(epoll_fd);
+    }
+
+    void fail(std::exception_ptr error) noexcept {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!loop_error) loop_error = error;
+        }
+        stop();
+    }
+
+    void serve(int epoll_fd, std::unordered_map<Connection*, std::unique_ptr<Connection>>& connections) {
+        Scratch scratch;
+        if (!watch_listener(epoll_fd)) {
+            throw std::system_error(errno, std::generic_category(), "Cannot add descriptor to epoll");
+        }
+        // The wake descriptor is tagged with this
+        add(epoll_fd, wake_fd, EPOLLIN, this);
+
+        epoll_event events[64];
+        bool running = true;
+        bool accepting = true;
+        std::chrono::steady_clock::time_point resume_at;
+        while (running) {
+            int timeout = -1;
+            if (!accepting) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    resume_at - std::chrono::steady_clock::now());
+                timeout = left.count() > 0 ? static_cast<int>(left.count()) : 0;
+            }
+            int ready = ::epoll_wait(epoll_fd, events, 64, timeout);
+            if (ready < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            bool closed = false;
+            for (int i = 0; i < ready; ++i) {
+                void* tag = events[i].data.ptr;
+                if (tag == nullptr) {
+                    if (accepting && !accept_all(epoll_fd, connections)) {
+                        ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, listen_fd, nullptr);
+                        accepting = false;
+                        resume_at = std::chrono::steady_clock::now() + accept_backoff;
+                    }
+                    continue;
+                }
+                if (tag == this) {
+                    running = false;
+                    continue;
+                }
+                Connection& connection = *static_cast<Connection*>(tag);
+                bool open = true;
+                try {
+                    if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                        open = receive(connection);
+                    }
+                    // Also on writability: frames may have been held back while the output was full
+                    for (;;) {
+                        bool stalled = false;
+                        open = handle_input(connection, scratch, stalled) && open;
+                        open = flush(epoll_fd, connection) && open;
+                        if (!open || !stalled || !connection.output.empty()) break;
+                    }
+                } catch (const std::bad_alloc&) {
+                    // Its buffers could not grow; the other clients carry on
+                    open = false;
+                }
+                if (!open) {
+                    ::close(connection.fd);
+                    connections.erase(&connection);
+                    closed = true;
+                }
+            }
+            // A closed connection freed a descriptor; otherwise wait out the backoff
+            if (!accepting && (closed || std::chrono::steady_clock::now() >= resume_at)) {
+                if (watch_listener(epoll_fd)) {
+                    accepting = true;
+                } else {
+                    resume_at = std::chrono::steady_clock::now() + accept_backoff;
+                }
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Create the socket and start listening; clients can connect before run()
+     * @param socket_path Where to create the Unix domain socket; a stale file there is removed
+     * @param threads Number of event-loop threads run() uses
+     * @param cache_capacity Most compiled expressions kept in the shared cache
+     * @throw std::system_error if the socket cannot be created, bound or listened on
+     * @throw std::invalid_argument if the path is too long or threads is zero
+     */
+    explicit Calc_Server(const std::string& socket_path, size_t threads = 1, size_t cache_capacity = 16384)
+        : path(socket_path), listen_fd(-1), wake_fd(-1), loops(threads), cache(cache_capacity),
+          connection_count(0), batch_count(0), expression_count(0), error_count(0), accept_failure_count(0) {
+        if (threads == 0) {
+            throw std::invalid_argument("Calc_Server needs at least one thread");
+        }
+        sockaddr_un address = calc_detail::socket_address(path);
+        listen_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listen_fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot create socket");
+        }
+        ::unlink(path.c_str());
+        if (::bind(listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(listen_fd, SOMAXCONN) != 0) {
+            int error = errno;
+            ::close(listen_fd);
+            throw std::system_error(error, std::generic_category(), "Cannot listen on " + path);
+        }
+        wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (wake_fd < 0) {
+            int error = errno;
+            ::close(listen_fd);
+            ::unlink(path.c_str());
+            throw std::system_error(error, std::generic_category(), "Cannot create eventfd");
+        }
+    }
+
+    Calc_Server(const Calc_Server&) = delete;
+    Calc_Server& operator=(const Calc_Server&) = delete;
+
+    /**
+     * @brief Close the socket and remove its file
+     */
+    ~Calc_Server() {
+        ::close(wake_fd);
+        ::close(listen_fd);
+        ::unlink(path.c_str());
+    }
+
+    /**
+     * @brief Serve clients on the event-loop threads until stop() is called
+     *
+     * The calling thread runs one of the loops. Once stopped, a server cannot be run again.
+     * @throw std::system_error if a loop cannot create or set up its epoll set, or a thread
+     *        cannot be started; the other loops are stopped and joined first
+     */
+    void run() {
+        std::vector<std::thread> threads;
+        try {
+            for (size_t i = 1; i < loops; ++i) {
+                threads.emplace_back([this] { loop(); });
+            }
+        } catch (...) {
+            fail(std::current_exception());
+        }
+        loop();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        if (loop_error) std::rethrow_exception(loop_error);
+    }
+
+    /**
+     * @brief Make every event loop return; safe to call from a signal handler
+     */
+    void stop() noexcept {
+        uint64_t one = 1;
+        // Nobody reads the eventfd, so it stays readable and wakes every loop.
+        // A signal handler must leave errno as it found it.
+        int saved_errno = errno;
+        ssize_t written;
+        do {
+            written = ::write(wake_fd, &one, sizeof(one));
+        } while (written < 0 && errno == EINTR);
+        errno = saved_errno;
+    }
+
+    /**
+     * @brief Get the connection, batch, expression and accept failure counters
+     */
+    [[nodiscard]] Calc_Server_Stats stats() const noexcept {
+        Calc_Server_Stats result;
+        result.connections = connection_count.load(std::memory_order_relaxed);
+        result.batches = batch_count.load(std::memory_order_relaxed);
+        result.expressions = expression_count.load(std::memory_order_relaxed);
+        result.errors = error_count.load(std::memory_order_relaxed);
+        result.accept_failures = accept_failure_count.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    /**
+     * @brief Get the shared cache's hit, miss and eviction counters
+     */
+    [[nodiscard]] Calc_Cache_Stats cache_stats() const {
+        return cache.stats();
+    }
+};
+
+#endif // defined(__linux__)
+
+#endif // CALC_SERVER_H
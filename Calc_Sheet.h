@@ -0,0 +1,339 @@
+/**
+ * @file Calc_Sheet.h
+ * @brief Named Calc cells whose formulas depend on each other, re-evaluated incrementally
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * A Calc_Sheet holds value cells and formula cells. A formula refers to other
+ * cells by name, the same way compiled expressions refer to variables, and the
+ * sheet keeps the dependency graph between them. Changing a cell only marks
+ * the formulas downstream of it dirty; recalculate() then evaluates just
+ * those, in topological order. Every formula has a level one above its
+ * deepest input, so the cells on one level never read each other and a level
+ * can be spread across a Thread_Pool.
+ */
+
+#ifndef CALC_SHEET_H
+#define CALC_SHEET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "Calc_Program.h"
+#include "Parallel.h"
+#include "Radix_Sort.h"
+
+namespace calc_detail {
+
+// Levels with fewer dirty cells than this are evaluated on the calling thread
+constexpr size_t sheet_parallel_cells = 256;
+constexpr size_t sheet_grain = 64;
+
+} // namespace calc_detail
+
+/**
+ * @brief A set of named cells holding values or formulas over other cells
+ * @tparam Num The arithmetic type the formulas are evaluated in
+ */
+template <class Num = long>
+class Calc_Sheet {
+private:
+    struct Cell {
+        std::string name;
+        Calc_Program<Num> program;          // empty for value cells
+        std::vector<uint32_t> inputs;       // one cell per entry of program.variables()
+        std::vector<uint32_t> dependents;   // formula cells reading this one
+        Num value;
+        Calc_Status status;
+        uint32_t level;                     // 0 for value cells, otherwise one above the deepest input
+        bool dirty;
+    };
+
+    // A deque never moves its elements, so the index can view the names in place
+    std::deque<Cell> cells;
+    std::unordered_map<std::string_view, uint32_t> index;
+    std::vector<uint32_t> dirty;
+
+    static bool valid_name(std::string_view name) noexcept {
+        if (name.empty() || !calc_detail::is_identifier_start(name[0])) return false;
+        return std::all_of(name.begin(), name.end(), calc_detail::is_identifier_char);
+    }
+
+    uint32_t find(std::string_view name) const {
+        auto found = index.find(name);
+        return found == index.end() ? UINT32_MAX : found->second;
+    }
+
+    const Cell& cell_named(std::string_view name) const {
+        uint32_t id = find(name);
+        if (id == UINT32_MAX) {
+            throw std::invalid_argument("No cell named " + std::string(name));
+        }
+        return cells[id];
+    }
+
+    // A cell referenced before it is set reports unbound_variable
+    uint32_t find_or_add(std::string_view name) {
+        uint32_t id = find(name);
+        if (id != UINT32_MAX) return id;
+        id = static_cast<uint32_t>(cells.size());
+        cells.push_back(Cell{std::string(name), {}, {}, {}, Num(), Calc_Status::unbound_variable, 0, false});
+        index.emplace(std::string_view(cells.back().name), id);
+        return id;
+    }
+
+    void mark_dirty(uint32_t id) {
+        std::vector<uint32_t> pending{id};
+        while (!pending.empty()) {
+            uint32_t current = pending.back();
+            pending.pop_back();
+            Cell& cell = cells[current];
+            if (cell.dirty) continue;
+            cell.dirty = true;
+            dirty.push_back(current);
+            pending.insert(pending.end(), cell.dependents.begin(), cell.dependents.end());
+        }
+    }
+
+    void mark_dependents_dirty(uint32_t id) {
+        for (uint32_t dependent : cells[id].dependents) mark_dirty(dependent);
+    }
+
+    // True if one of targets is id itself or lies downstream of it
+    bool reaches(uint32_t id, const std::vector<uint32_t>& targets) const {
+        std::vector<bool> seen(cells.size(), false);
+        std::vector<uint32_t> pending{id};
+        while (!pending.empty()) {
+            uint32_t current = pending.back();
+            pending.pop_back();
+            if (seen[current]) continue;
+            seen[current] = true;
+            if (std::find(targets.begin(), targets.end(), current) != targets.end()) return true;
+            const std::vector<uint32_t>& next = cells[current].dependents;
+            pending.insert(pending.end(), next.begin(), next.end());
+        }
+        return false;
+    }
+
+    void detach_inputs(uint32_t id) {
+        for (uint32_t input : cells[id].inputs) {
+            std::vector<uint32_t>& readers = cells[input].dependents;
+            auto found = std::find(readers.begin(), readers.end(), id);
+            *found = readers.back();
+            readers.pop_back();
+        }
+        cells[id].inputs.clear();
+    }
+
+    // Recomputes the level of id, then of the cells downstream for as long as levels change
+    void update_levels(uint32_t id) {
+        std::vector<uint32_t> pending{id};
+        while (!pending.empty()) {
+            Cell& cell = cells[pending.back()];
+            pending.pop_back();
+            uint32_t level = 0;
+            for (uint32_t input : cell.inputs) level = std::max(level, cells[input].level + 1);
+            if (level == cell.level) continue;
+            cell.level = level;
+            pending.insert(pending.end(), cell.dependents.begin(), cell.dependents.end());
+        }
+    }
+
+    void evaluate_cell(uint32_t id, std::vector<Num>& values) {
+        Cell& cell = cells[id];
+        cell.dirty = false;
+        values.resize(cell.inputs.size());
+        cell.status = Calc_Status::ok;
+        for (size_t i = 0; i < cell.inputs.size(); ++i) {
+            const Cell& input = cells[cell.inputs[i]];
+            if (input.status != Calc_Status::ok) {
+                // An error travels downstream the way #DIV/0! does in a spreadsheet
+                cell.status = input.status;
+                break;
+            }
+            values[i] = input.value;
+        }
+        if (cell.status == Calc_Status::ok) {
+            cell.status = calc_evaluate(cell.program, cell.value, values.data());
+        }
+        if (cell.status != Calc_Status::ok) {
+            cell.value = Num();
+        }
+    }
+
+    size_t recalculate_dirty(Thread_Pool* pool) {
+        std::vector<uint32_t> order;
+        order.swap(dirty);
+        radix_sort(order.data(), order.size(), [this](uint32_t id) { return cells[id].level; });
+
+        std::vector<Num> values;
+        for (size_t begin = 0; begin < order.size();) {
+            size_t end = begin;
+            while (end < order.size() && cells[order[end]].level == cells[order[begin]].level) ++end;
+            if (pool != nullptr && end - begin >= calc_detail::sheet_parallel_cells) {
+                parallel_for(*pool, end - begin, [&](size_t first, size_t last) {
+                    std::vector<Num> scratch;
+                    for (size_t i = first; i < last; ++i) evaluate_cell(order[begin + i], scratch);
+                }, calc_detail::sheet_grain);
+            } else {
+                for (size_t i = begin; i < end; ++i) evaluate_cell(order[i], values);
+            }
+            begin = end;
+        }
+        return order.size();
+    }
+
+public:
+    Calc_Sheet() = default;
+
+    Calc_Sheet(const Calc_Sheet&) = delete;
+    Calc_Sheet& operator=(const Calc_Sheet&) = delete;
+
+    /**
+     * @brief Give a cell a constant value, replacing any formula it had
+     * @param name The cell name, an identifier such as revenue or b2
+     * @param value The new value
+     * @throw std::invalid_argument if name is not an identifier
+     */
+    void set_value(std::string_view name, Num value) {
+        if (!valid_name(name)) {
+            throw std::invalid_argument("Invalid cell name " + std::string(name));
+        }
+        uint32_t id = find_or_add(name);
+        Cell& cell = cells[id];
+        if (!cell.program.empty()) {
+            detach_inputs(id);
+            cell.program = Calc_Program<Num>();
+            if (cell.dirty) {
+                cell.dirty = false;
+                dirty.erase(std::find(dirty.begin(), dirty.end(), id));
+            }
+            update_levels(id);
+        }
+        cell.value = value;
+        cell.status = Calc_Status::ok;
+        mark_dependents_dirty(id);
+    }
+
+    /**
+     * @brief Give a cell a formula over other cells, replacing what it had
+     *
+     * Cells the formula names but that do not exist yet are created unset.
+     * On failure the sheet is left unchanged.
+     *
+     * @param name The cell name
+     * @param formula An expression whose variables are cell names, such as price * quantity
+     * @throw std::invalid_argument if name is invalid, the formula does not compile,
+     *        or the formula would make the cell depend on itself
+     */
+    void set_formula(std::string_view name, std::string_view formula) {
+        if (!valid_name(name)) {
+            throw std::invalid_argument("Invalid cell name " + std::string(name));
+        }
+        Calc_Program<Num> program = compile<Num>(formula);
+        uint32_t id = find(name);
+        std::vector<uint32_t> existing;
+        for (const std::string& variable : program.variables()) {
+            if (variable == name) {
+                throw std::invalid_argument("Formula for " + std::string(name) + " refers to itself");
+            }
+            uint32_t input = find(variable);
+            if (input != UINT32_MAX) existing.push_back(input);
+        }
+        if (id != UINT32_MAX && reaches(id, existing)) {
+            throw std::invalid_argument("Formula for " + std::string(name) + " would create a cycle");
+        }
+
+        id = find_or_add(name);
+        detach_inputs(id);
+        for (const std::string& variable : program.variables()) {
+            uint32_t input = find_or_add(variable);
+            cells[id].inputs.push_back(input);
+            cells[input].dependents.push_back(id);
+        }
+        cells[id].program = std::move(program);
+        update_levels(id);
+        mark_dirty(id);
+    }
+
+    /**
+     * @brief Evaluate every dirty formula, inputs before the formulas that read them
+     * @return The number of formulas evaluated
+     */
+    size_t recalculate() {
+        return recalculate_dirty(nullptr);
+    }
+
+    /**
+     * @brief Evaluate every dirty formula, spreading each level of independent cells across a pool
+     * @param pool The pool to run on
+     * @return The number of formulas evaluated
+     */
+    size_t recalculate(Thread_Pool& pool) {
+        return recalculate_dirty(&pool);
+    }
+
+    /**
+     * @brief Mark every formula dirty, so the next recalculate() evaluates the whole sheet
+     */
+    void mark_all_dirty() {
+        for (uint32_t id = 0; id < cells.size(); ++id) {
+            if (!cells[id].program.empty() && !cells[id].dirty) {
+                cells[id].dirty = true;
+                dirty.push_back(id);
+            }
+        }
+    }
+
+    /**
+     * @brief Get a cell's value as of the last recalculate()
+     * @param name The cell name
+     * @return The value
+     * @throw std::invalid_argument if there is no such cell
+     * @throw std::runtime_error if the cell is unset or its formula failed
+     */
+    [[nodiscard]] Num value(std::string_view name) const {
+        const Cell& cell = cell_named(name);
+        if (cell.status != Calc_Status::ok) {
+            throw std::runtime_error("Cell " + cell.name + " has no value: " + calc_status_message(cell.status));
+        }
+        return cell.value;
+    }
+
+    /**
+     * @brief Get whether a cell's last evaluation succeeded, and why not if it failed
+     * @param name The cell name
+     * @throw std::invalid_argument if there is no such cell
+     */
+    [[nodiscard]] Calc_Status status(std::string_view name) const {
+        return cell_named(name).status;
+    }
+
+    [[nodiscard]] bool contains(std::string_view name) const {
+        return find(name) != UINT32_MAX;
+    }
+
+    /**
+     * @brief Get the number of cells, including ones only referenced by formulas
+     */
+    [[nodiscard]] size_t size() const noexcept {
+        return cells.size();
+    }
+
+    /**
+     * @brief Get the number of formulas the next recalculate() will evaluate
+     */
+    [[nodiscard]] size_t dirty_count() const noexcept {
+        return dirty.size();
+    }
+};
+
+#endif // CALC_SHEET_H
@@ -0,0 +1,387 @@
+/**
+ * @file Calc_Stream.h
+ * @brief Evaluate files of one Calc expression per line through memory mapping and buffered output
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * The input file is mapped read-only and every line is compiled straight from
+ * the mapped bytes as a string_view, so no line is ever copied into a
+ * std::string. Results go through an Output_Sink that collects them in a large
+ * buffer and writes it with few system calls. The parallel mode cuts the
+ * input at newline boundaries into chunks, evaluates a wave of chunks on a
+ * Thread_Pool and writes their output in input order before starting the next
+ * wave, so memory stays bounded however large the file is.
+ */
+
+#ifndef CALC_STREAM_H
+#define CALC_STREAM_H
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Calc_Batch.h"
+
+/**
+ * @brief A read-only memory mapping of a whole file
+ */
+class Mapped_File {
+private:
+    void* mapping;
+    size_t length;
+
+public:
+    /**
+     * @brief Map a file for sequential reading
+     * @param path The file to map
+     * @throw std::system_error if the file cannot be opened, inspected or mapped
+     */
+    explicit Mapped_File(const std::string& path) : mapping(nullptr), length(0) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "Cannot stat " + path);
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length > 0) {
+            mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "Cannot map " + path);
+            }
+#ifdef MADV_SEQUENTIAL
+            ::madvise(mapping, length, MADV_SEQUENTIAL);
+#endif
+        }
+        ::close(fd);
+    }
+
+    Mapped_File(const Mapped_File&) = delete;
+    Mapped_File& operator=(const Mapped_File&) = delete;
+
+    ~Mapped_File() {
+        if (mapping != nullptr) {
+            ::munmap(mapping, length);
+        }
+    }
+
+    /**
+     * @brief Get the file contents
+     */
+    [[nodiscard]] std::string_view view() const noexcept {
+        return mapping != nullptr ? std::string_view(static_cast<const char*>(mapping), length) : std::string_view();
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return length;
+    }
+};
+
+/**
+ * @brief A large write buffer in front of a file descriptor
+ */
+class Output_Sink {
+private:
+    int fd;
+    bool owns_fd;
+    std::vector<char> buffer;
+    size_t used;
+
+    void write_all(const char* data, size_t size) {
+        while (size > 0) {
+            ssize_t written = ::write(fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw std::system_error(errno, std::generic_category(), "Cannot write output");
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+    }
+
+public:
+    /**
+     * @brief Write to an already open descriptor, which the sink does not close
+     * @param fd The descriptor, for example STDOUT_FILENO
+     * @param capacity Bytes buffered before a write
+     */
+    explicit Output_Sink(int fd, size_t capacity = size_t(1) << 20)
+        : fd(fd), owns_fd(false), buffer(std::max<size_t>(capacity, 64)), used(0) {}
+
+    /**
+     * @brief Create or truncate a file and write to it
+     * @param path The output file
+     * @param capacity Bytes buffered before a write
+     * @throw std::system_error if the file cannot be opened
+     */
+    explicit Output_Sink(const std::string& path, size_t capacity = size_t(1) << 20)
+        : fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)), owns_fd(true),
+          buffer(std::max<size_t>(capacity, 64)), used(0) {
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "Cannot open " + path);
+        }
+    }
+
+    Output_Sink(const Output_Sink&) = delete;
+    Output_Sink& operator=(const Output_Sink&) = delete;
+
+    /**
+     * @brief Flush what is left; errors at this point are ignored, so call flush() to see them
+     */
+    ~Output_Sink() {
+        try {
+            flush();
+        } catch (...) {
+        }
+        if (owns_fd) {
+            ::close(fd);
+        }
+    }
+
+    /**
+     * @brief Append bytes, writing the buffer out when it fills
+     * @param text The bytes to append
+     */
+    void write(std::string_view text) {
+        if (text.size() > buffer.size() - used) {
+            flush();
+            if (text.size() >= buffer.size()) {
+                write_all(text.data(), text.size());
+                return;
+            }
+        }
+        std::memcpy(buffer.data() + used, text.data(), text.size());
+        used += text.size();
+    }
+
+    /**
+     * @brief Write out everything buffered so far
+     * @throw std::system_error if the write fails
+     */
+    void flush() {
+        if (used > 0) {
+            size_t size = used;
+            used = 0;
+            write_all(buffer.data(), size);
+        }
+    }
+};
+
+/**
+ * @brief What a streaming run processed
+ */
+struct Calc_Stream_Stats {
+    size_t lines = 0;
+    size_t errors = 0;
+};
+
+namespace calc_detail {
+
+constexpr size_t stream_chunk_bytes = size_t(4) << 20;
+
+// Writes the shortest %g form that reads back as value, which is what
+// to_chars gives, for standard libraries without floating-point to_chars
+template <class Num>
+char* format_float(char* first, Num value) {
+    char text[64];
+    int length = 0;
+    for (int precision = 1; precision <= std::numeric_limits<Num>::max_digits10; ++precision) {
+        if constexpr (std::is_same<Num, long double>::value) {
+            length = std::snprintf(text, sizeof(text), "%.*Lg", precision, value);
+            if (std::strtold(text, nullptr) == value) break;
+        } else {
+            length = std::snprintf(text, sizeof(text), "%.*g", precision, static_cast<double>(value));
+            if (static_cast<Num>(std::strtod(text, nullptr)) == value) break;
+        }
+    }
+    char point = locale_decimal_point();
+    if (point != '.') std::replace(text, text + length, point, '.');
+    return std::copy(text, text + length, first);
+}
+
+// Writes value in decimal and returns the end; 64 bytes always suffice
+template <class Num>
+char* format_number(char* first, Num value) {
+    if constexpr (std::is_integral<Num>::value || (std::is_floating_point<Num>::value && float_charconv)) {
+        return std::to_chars(first, first + 64, value).ptr;
+    } else if constexpr (std::is_floating_point<Num>::value) {
+        return format_float(first, value);
+    } else {
+        // No to_chars for __int128 in strict ISO mode; digits are taken from the
+        // negative side so the most negative value needs no special case
+        char digits[48];
+        char* end = digits + sizeof(digits);
+        char* position = end;
+        bool negative = value < 0;
+        do {
+            int digit = static_cast<int>(value % 10);
+            *--position = static_cast<char>('0' + (digit < 0 ? -digit : digit));
+            value /= 10;
+        } while (value != 0);
+        if (negative) *--position = '-';
+        return std::copy(position, end, first);
+    }
+}
+
+// Appends "value\n", or "error: message\n" when the line failed
+template <class Num, class Out>
+bool format_line(std::string_view line, Out& out) {
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    Num value;
+    Calc_Status status = evaluate_one(line, value);
+    if (status != Calc_Status::ok) {
+        out.write("error: ");
+        out.write(calc_status_message(status));
+        out.write("\n");
+        return false;
+    }
+    char text[65];
+    char* end = format_number(text, value);
+    *end++ = '\n';
+    out.write(std::string_view(text, static_cast<size_t>(end - text)));
+    return true;
+}
+
+template <class Num, class Out>
+Calc_Stream_Stats evaluate_lines_into(std::string_view input, Out& out) {
+    Calc_Stream_Stats stats;
+    while (!input.empty()) {
+        size_t newline = input.find('\n');
+        std::string_view line = input.substr(0, newline);
+        input.remove_prefix(newline == std::string_view::npos ? input.size() : newline + 1);
+        ++stats.lines;
+        stats.errors += !format_line<Num>(line, out);
+    }
+    return stats;
+}
+
+// Collects one chunk's output in memory during the parallel mode
+struct String_Out {
+    std::string text;
+
+    void write(std::string_view bytes) {
+        text.append(bytes.data(), bytes.size());
+    }
+};
+
+// Cuts input into pieces of about chunk bytes, each ending just after a newline
+inline std::vector<std::string_view> split_chunks(std::string_view input, size_t chunk) {
+    std::vector<std::string_view> chunks;
+    while (!input.empty()) {
+        size_t end = input.size();
+        if (end > chunk) {
+            size_t newline = input.find('\n', chunk);
+            end = newline == std::string_view::npos ? input.size() : newline + 1;
+        }
+        chunks.push_back(input.substr(0, end));
+        input.remove_prefix(end);
+    }
+    return chunks;
+}
+
+} // namespace calc_detail
+
+/**
+ * @brief Evaluate every line of a buffer, writing one result line per input line
+ * @param input Expressions separated by '\n' (a trailing '\r' is ignored)
+ * @param out The sink receiving the value or "error: message" for each line
+ * @return The number of lines and how many failed
+ */
+template <class Num = long>
+Calc_Stream_Stats evaluate_stream(std::string_view input, Output_Sink& out) {
+    return calc_detail::evaluate_lines_into<Num>(input, out);
+}
+
+/**
+ * @brief Evaluate a buffer in parallel, keeping the output in input order
+ * @param pool The pool to run on
+ * @param input Expressions separated by '\n'
+ * @param out The sink receiving one result line per input line
+ * @param chunk_bytes Approximate bytes of input per task
+ * @return The number of lines and how many failed
+ */
+template <class Num = long>
+Calc_Stream_Stats evaluate_stream(Thread_Pool& pool, std::string_view input, Output_Sink& out,
+                                  size_t chunk_bytes = calc_detail::stream_chunk_bytes) {
+    std::vector<std::string_view> chunks = calc_detail::split_chunks(input, std::max<size_t>(chunk_bytes, 1));
+    size_t wave = pool.size() * 2;
+    std::vector<calc_detail::String_Out> outputs(std::min(wave, chunks.size()));
+    std::vector<Calc_Stream_Stats> chunk_stats(outputs.size());
+    Calc_Stream_Stats total;
+    for (size_t first = 0; first < chunks.size(); first += wave) {
+        size_t count = std::min(wave, chunks.size() - first);
+        parallel_for(pool, count, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                outputs[i].text.clear();
+                chunk_stats[i] = calc_detail::evaluate_lines_into<Num>(chunks[first + i], outputs[i]);
+            }
+        }, 1);
+        for (size_t i = 0; i < count; ++i) {
+            out.write(outputs[i].text);
+            total.lines += chunk_stats[i].lines;
+            total.errors += chunk_stats[i].errors;
+        }
+    }
+    return total;
+}
+
+/**
+ * @brief Evaluate a file of one expression per line into an output file
+ * @param input_path The file to read through a memory mapping
+ * @param output_path The file to create or truncate
+ * @return The number of lines and how many failed
+ * @throw std::system_error if a file cannot be opened, mapped or written
+ */
+template <class Num = long>
+Calc_Stream_Stats evaluate_file(const std::string& input_path, const std::string& output_path) {
+    Mapped_File input(input_path);
+    Output_Sink out(output_path);
+    Calc_Stream_Stats stats = evaluate_stream<Num>(input.view(), out);
+    out.flush();
+    return stats;
+}
+
+/**
+ * @brief Evaluate a file in parallel, keeping the output in input order
+ * @param pool The pool to run on
+ * @param input_path The file to read through a memory mapping
+ * @param output_path The file to create or truncate
+ * @return The number of lines and how many failed
+ * @throw std::system_error if a file cannot be opened, mapped or written
+ */
+template <class Num = long>
+Calc_Stream_Stats evaluate_file(Thread_Pool& pool, const std::string& input_path, const std::string& output_path) {
+    Mapped_File input(input_path);
+    Output_Sink out(output_path);
+    Calc_Stream_Stats stats = evaluate_stream<Num>(pool, input.view(), out);
+    out.flush();
+    return stats;
+}
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+#endif // CALC_STREAM_H
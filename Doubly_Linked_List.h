@@ -12,13 +12,18 @@
 #include <stdexcept> // For std::out_of_range
 #include <iostream>  // For the print() method
 #include <iterator>
+#include <utility>
+#include <vector>
+
+#include "Memory_Stats.h"
+#include "Radix_Sort.h"
 
 /**
  * @brief A template-based doubly linked list implementation
  * @tparam T The type of elements stored in the list
  */
 template <class T>
-class Doubly_Linked_List {
+class Doubly_Linked_List : public Memory_Tracked<Doubly_Linked_List<T>> {
 private:
     /**
      * @brief Node structure for the doubly linked list
@@ -43,6 +48,9 @@ public:
     using const_reference = const T&;
     using size_type = size_t;
 
+    /// Name the node allocations are counted under, see Memory_Stats.h
+    static constexpr const char* memory_name = "Doubly_Linked_List";
+
     /**
      * @brief Default constructor
      */
@@ -52,7 +60,8 @@ public:
      * @brief Copy constructor
      * @param other The list to copy from
      */
-    Doubly_Linked_List(const Doubly_Linked_List& other) : front(nullptr), back(nullptr), length(0) {
+    Doubly_Linked_List(const Doubly_Linked_List& other)
+        : Memory_Tracked<Doubly_Linked_List<T>>(), front(nullptr), back(nullptr), length(0) {
         Node* temp = other.front;
         while (temp != nullptr) {
             push_back(temp->item);
@@ -64,8 +73,8 @@ public:
      * @brief Move constructor
      * @param other The list to move from
      */
-    Doubly_Linked_List(Doubly_Linked_List&& other) noexcept 
-        : front(other.front), back(other.back), length(other.length) {
+    Doubly_Linked_List(Doubly_Linked_List&& other) noexcept
+        : Memory_Tracked<Doubly_Linked_List<T>>(std::move(other)), front(other.front), back(other.back), length(other.length) {
         other.front = nullptr;
         other.back = nullptr;
         other.length = 0;
@@ -96,6 +105,7 @@ public:
     Doubly_Linked_List& operator=(Doubly_Linked_List&& other) noexcept {
         if (this != &other) {
             clear();
+            this->adopt_memory(other);
             front = other.front;
             back = other.back;
             length = other.length;
@@ -134,7 +144,7 @@ public:
      * @param value The value to add
      */
     void push_back(const T& value) {
-        Node* new_node = new Node(value);
+        Node* new_node = this->template allocate_node<Node>(value);
         if (empty()) {
             front = back = new_node;
         } else {
@@ -150,7 +160,7 @@ public:
      * @param value The value to add
      */
     void push_back(T&& value) {
-        Node* new_node = new Node(std::move(value));
+        Node* new_node = this->template allocate_node<Node>(std::move(value));
         if (empty()) {
             front = back = new_node;
         } else {
@@ -162,7 +172,7 @@ public:
     }
 
     void push_front (T new_item) {
-        Node* new_node = new Node(new_item);
+        Node* new_node = this->template allocate_node<Node>(new_item);
         if (empty()) {
             front = back = new_node;
         }
@@ -201,7 +211,7 @@ public:
                 }
             }
 
-            Node* new_node = new Node(new_item);
+            Node* new_node = this->template allocate_node<Node>(new_item);
             new_node->next = temp;
             new_node->prev = temp->prev;
             temp->prev->next = new_node;
@@ -220,7 +230,7 @@ public:
             back = back->prev;
             back->next = nullptr;
         }
-        delete temp;
+        this->free_node(temp);
         --length;
     }
 
@@ -233,7 +243,7 @@ public:
             front = front->next;
             front->prev = nullptr;
         }
-        delete temp;
+        this->free_node(temp);
         --length;
     }
 
@@ -268,7 +278,7 @@ public:
         }
         temp->next->prev = temp->prev;
         temp->prev->next = temp->next;
-        delete temp;
+        this->free_node(temp);
         --length;
     }
 
@@ -276,40 +286,61 @@ public:
         Node* current = front;
         while (current != nullptr) {
             Node* next_node = current->next;
-            delete current;
+            this->free_node(current);
             current = next_node;
         }
         front = back = nullptr;
         length = 0;
     }
 
-    // FIX: The original implementation did not correctly swap the pointers.
+    /**
+     * @brief Reverse the list in-place
+     */
     void reverse() {
-        if (empty() || length == 1) {
+        if (length < 2) {
             return;
         }
-
-        Node* current = front;
-        Node* temp_ptr = nullptr;
-
-        // Iterate through the list and swap the next and prev pointers for each node
-        while (current != nullptr) {
-            temp_ptr = current->prev;       // Store the original previous pointer
-            current->prev = current->next;  // The new prev is the original next
-            current->next = temp_ptr;       // The new next is the original prev
-            current = current->prev;        // Move to the next node (which is the original next)
+        // Swap next and prev in every node; the old next is now in prev
+        for (Node* current = front; current != nullptr; current = current->prev) {
+            std::swap(current->next, current->prev);
         }
+        std::swap(front, back);
+    }
 
-        // After swapping all pointers, swap the main front and back pointers of the list.
-        // The original front's prev pointer (which is now in `temp_ptr`) is the new head.
-        if (temp_ptr != nullptr) {
-             front = temp_ptr->prev;
+    /**
+     * @brief Stable sort by an integer or floating-point key
+     *
+     * The node pointers are copied into an array, radix sorted there by key and
+     * relinked, so no element is copied or moved.
+     *
+     * @param key Callable taking const T& and returning the key
+     */
+    template <class Key>
+    void radix_sort(Key key) {
+        if (length < 2) {
+            return;
+        }
+        std::vector<Node*> nodes;
+        nodes.reserve(length);
+        for (Node* temp = front; temp != nullptr; temp = temp->next) {
+            nodes.push_back(temp);
         }
+        ::radix_sort(nodes.data(), nodes.size(), [&key](const Node* node) { return key(node->item); });
+        front = nodes.front();
+        front->prev = nullptr;
+        for (size_t i = 1; i < nodes.size(); ++i) {
+            nodes[i - 1]->next = nodes[i];
+            nodes[i]->prev = nodes[i - 1];
+        }
+        back = nodes.back();
+        back->next = nullptr;
+    }
 
-        // A simpler way to swap front and back after the pointer surgery:
-        temp_ptr = front;
-        front = back;
-        back = temp_ptr;
+    /**
+     * @brief Sort a list of integer or floating-point values in ascending order
+     */
+    void radix_sort() {
+        radix_sort([](const T& value) { return value; });
     }
 
     void print() const {
@@ -0,0 +1,352 @@
+/**
+ * @file Gap_Buffer.h
+ * @brief A template-based gap buffer for edits clustered around a cursor
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ */
+
+#ifndef GAP_BUFFER_H
+#define GAP_BUFFER_H
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief A dynamic array that keeps a movable gap at the cursor
+ *
+ * Elements before the cursor live in [0, gap_begin) and elements after it in
+ * [gap_end, capacity). Inserting or erasing at the cursor only resizes the gap,
+ * moving the cursor moves the elements it crosses, and indexing skips the gap.
+ *
+ * @tparam T The type of elements stored in the buffer
+ */
+template <class T>
+class Gap_Buffer {
+private:
+    T* buffer;
+    size_t capacity;
+    size_t gap_begin;
+    size_t gap_end;
+
+    /**
+     * @brief Move count elements from src to dst; the ranges may overlap
+     */
+    static void relocate(T* dst, T* src, size_t count) {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            std::memmove(dst, src, count * sizeof(T));
+        } else if (dst < src) {
+            std::move(src, src + count, dst);
+        } else {
+            std::move_backward(src, src + count, dst + count);
+        }
+    }
+
+    /**
+     * @brief Reallocate with room for at least min_gap more elements
+     */
+    void grow(size_t min_gap) {
+        size_t tail = capacity - gap_end;
+        size_t new_capacity = std::max(capacity * 2, capacity + min_gap);
+        new_capacity = std::max<size_t>(new_capacity, 16);
+        T* new_buffer = new T[new_capacity];
+        try {
+            std::move(buffer, buffer + gap_begin, new_buffer);
+            std::move(buffer + gap_end, buffer + capacity, new_buffer + new_capacity - tail);
+        } catch (...) {
+            delete[] new_buffer;
+            throw;
+        }
+        delete[] buffer;
+        buffer = new_buffer;
+        gap_end = new_capacity - tail;
+        capacity = new_capacity;
+    }
+
+public:
+    // Type definitions for STL compatibility
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+
+    /**
+     * @brief Constructor
+     * @param initial_capacity Number of elements to reserve up front
+     */
+    explicit Gap_Buffer(size_t initial_capacity = 16)
+        : buffer(new T[initial_capacity]), capacity(initial_capacity), gap_begin(0), gap_end(initial_capacity) {}
+
+    /**
+     * @brief Copy constructor
+     * @param other The buffer to copy from
+     */
+    Gap_Buffer(const Gap_Buffer& other)
+        : buffer(new T[other.capacity]), capacity(other.capacity),
+          gap_begin(other.gap_begin), gap_end(other.gap_end) {
+        std::copy(other.buffer, other.buffer + gap_begin, buffer);
+        std::copy(other.buffer + gap_end, other.buffer + capacity, buffer + gap_end);
+    }
+
+    /**
+     * @brief Move constructor
+     * @param other The buffer to move from
+     */
+    Gap_Buffer(Gap_Buffer&& other) noexcept
+        : buffer(other.buffer), capacity(other.capacity), gap_begin(other.gap_begin), gap_end(other.gap_end) {
+        other.buffer = nullptr;
+        other.capacity = other.gap_begin = other.gap_end = 0;
+    }
+
+    /**
+     * @brief Copy assignment operator
+     * @param other The buffer to copy from
+     * @return Reference to this buffer
+     */
+    Gap_Buffer& operator=(const Gap_Buffer& other) {
+        if (this != &other) {
+            Gap_Buffer copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator
+     * @param other The buffer to move from
+     * @return Reference to this buffer
+     */
+    Gap_Buffer& operator=(Gap_Buffer&& other) noexcept {
+        if (this != &other) {
+            delete[] buffer;
+            buffer = other.buffer;
+            capacity = other.capacity;
+            gap_begin = other.gap_begin;
+            gap_end = other.gap_end;
+            other.buffer = nullptr;
+            other.capacity = other.gap_begin = other.gap_end = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destructor
+     */
+    ~Gap_Buffer() {
+        delete[] buffer;
+    }
+
+    /**
+     * @brief Get the number of stored elements
+     * @return The number of elements in the buffer
+     */
+    [[nodiscard]] size_t size() const noexcept {
+        return capacity - (gap_end - gap_begin);
+    }
+
+    /**
+     * @brief Check if the buffer is empty
+     * @return true if the buffer is empty, false otherwise
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Get the cursor position
+     * @return The index the next insert() will occupy
+     */
+    [[nodiscard]] size_t cursor() const noexcept {
+        return gap_begin;
+    }
+
+    /**
+     * @brief Get the contiguous elements before the cursor
+     * @return Pointer to cursor() elements
+     */
+    [[nodiscard]] const T* data_before_gap() const noexcept {
+        return buffer;
+    }
+
+    /**
+     * @brief Get the contiguous elements after the cursor
+     * @return Pointer to size() - cursor() elements
+     */
+    [[nodiscard]] const T* data_after_gap() const noexcept {
+        return buffer + gap_end;
+    }
+
+    /**
+     * @brief Move the cursor, shifting only the elements it crosses
+     * @param pos The new cursor position, in [0, size()]
+     * @throw std::out_of_range if pos is past the end
+     */
+    void move_cursor(size_t pos) {
+        if (pos > size()) {
+            throw std::out_of_range("Index out of range in move_cursor()");
+        }
+        if (pos < gap_begin) {
+            size_t count = gap_begin - pos;
+            relocate(buffer + gap_end - count, buffer + pos, count);
+            gap_begin -= count;
+            gap_end -= count;
+        } else if (pos > gap_begin) {
+            size_t count = pos - gap_begin;
+            relocate(buffer + gap_begin, buffer + gap_end, count);
+            gap_begin += count;
+            gap_end += count;
+        }
+    }
+
+    /**
+     * @brief Insert an element at the cursor and advance past it
+     * @param value The value to insert
+     */
+    void insert(const T& value) {
+        if (gap_begin == gap_end) {
+            // value may be an element of this buffer, which grow() moves and frees
+            T copy(value);
+            grow(1);
+            buffer[gap_begin++] = std::move(copy);
+        } else {
+            buffer[gap_begin++] = value;
+        }
+    }
+
+    /**
+     * @brief Insert an element at the cursor using move semantics
+     * @param value The value to insert
+     */
+    void insert(T&& value) {
+        if (gap_begin == gap_end) {
+            T moved(std::move(value));
+            grow(1);
+            buffer[gap_begin++] = std::move(moved);
+        } else {
+            buffer[gap_begin++] = std::move(value);
+        }
+    }
+
+    /**
+     * @brief Insert an element at a specific position and leave the cursor after it
+     * @param index The position to insert at
+     * @param value The value to insert
+     * @throw std::out_of_range if index is out of range
+     */
+    void insert(size_t index, const T& value) {
+        if (index > size()) {
+            throw std::out_of_range("Index out of range in insert()");
+        }
+        // Moving the cursor moves the elements it crosses, which value may be one of
+        T copy(value);
+        move_cursor(index);
+        insert(std::move(copy));
+    }
+
+    /**
+     * @brief Remove the element just before the cursor
+     * @throw std::runtime_error if the cursor is at the beginning
+     */
+    void erase_before() {
+        if (gap_begin == 0) {
+            throw std::runtime_error("Cursor at beginning in erase_before()");
+        }
+        --gap_begin;
+    }
+
+    /**
+     * @brief Remove the element just after the cursor
+     * @throw std::runtime_error if the cursor is at the end
+     */
+    void erase_after() {
+        if (gap_end == capacity) {
+            throw std::runtime_error("Cursor at end in erase_after()");
+        }
+        ++gap_end;
+    }
+
+    /**
+     * @brief Remove the element at a specific position and leave the cursor there
+     * @param index The position to remove from
+     * @throw std::out_of_range if index is out of range
+     */
+    void erase(size_t index) {
+        if (index >= size()) {
+            throw std::out_of_range("Index out of range in erase()");
+        }
+        move_cursor(index);
+        erase_after();
+    }
+
+    /**
+     * @brief Add an element to the end of the buffer
+     * @param value The value to add
+     */
+    void push_back(const T& value) {
+        insert(size(), value);
+    }
+
+    /**
+     * @brief Access an element by index
+     * @param index The position of the element
+     * @return Reference to the element
+     * @throw std::out_of_range if index is out of range
+     */
+    T& at(size_t index) {
+        if (index >= size()) {
+            throw std::out_of_range("Index out of range in at()");
+        }
+        return (*this)[index];
+    }
+
+    /**
+     * @brief Access an element by index
+     * @param index The position of the element
+     * @return Const reference to the element
+     * @throw std::out_of_range if index is out of range
+     */
+    const T& at(size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("Index out of range in at()");
+        }
+        return (*this)[index];
+    }
+
+    /**
+     * @brief Access an element by index without bounds checking
+     */
+    T& operator[](size_t index) noexcept {
+        return buffer[index < gap_begin ? index : index + (gap_end - gap_begin)];
+    }
+
+    /**
+     * @brief Access an element by index without bounds checking
+     */
+    const T& operator[](size_t index) const noexcept {
+        return buffer[index < gap_begin ? index : index + (gap_end - gap_begin)];
+    }
+
+    /**
+     * @brief Remove all elements and reset the cursor
+     */
+    void clear() noexcept {
+        gap_begin = 0;
+        gap_end = capacity;
+    }
+
+    /**
+     * @brief Print the buffer contents to standard output
+     */
+    void print() const {
+        std::cout << "[ ";
+        for (size_t i = 0; i < size(); ++i) {
+            std::cout << (*this)[i] << ' ';
+        }
+        std::cout << ']' << std::endl;
+    }
+};
+
+#endif // GAP_BUFFER_H
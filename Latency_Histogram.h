@@ -0,0 +1,255 @@
+/**
+ * @file Latency_Histogram.h
+ * @brief Log-bucketed latency histograms in the style of HdrHistogram, and timed queue/stack adapters
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * Values are nanoseconds. Each power of two is split into 64 linear
+ * sub-buckets, so a recorded value is known to within 1/64 (about 1.6%) at
+ * any magnitude, from 1 ns up to the full 64-bit range, in a fixed ~30 KB
+ * array. Recording is a count-leading-zeros and an increment, with no
+ * allocation and no locking, so each thread records into its own histogram
+ * and merge() adds them together afterwards.
+ *
+ * Timed_Queue and Timed_Stack wrap a queue (enqueue/dequeue) or a stack
+ * (push/pop) and record the latency of every call, for code that wants the
+ * distribution of a live container rather than a benchmark's.
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace latency_detail {
+
+constexpr unsigned sub_bucket_bits = 6;
+constexpr uint64_t sub_buckets = uint64_t(1) << sub_bucket_bits;
+// Values below sub_buckets are exact; every higher power of two gets sub_buckets more
+constexpr size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_buckets;
+
+inline unsigned highest_bit(uint64_t value) noexcept {
+#if defined(__GNUC__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+    unsigned bit = 0;
+    while (value >>= 1) ++bit;
+    return bit;
+#endif
+}
+
+inline size_t bucket_of(uint64_t value) noexcept {
+    if (value < sub_buckets) return static_cast<size_t>(value);
+    unsigned shift = highest_bit(value) - sub_bucket_bits;
+    return static_cast<size_t>((shift + 1) * sub_buckets + ((value >> shift) - sub_buckets));
+}
+
+// The largest value that lands in a bucket
+inline uint64_t bucket_high(size_t bucket) noexcept {
+    if (bucket < sub_buckets) return bucket;
+    unsigned shift = static_cast<unsigned>(bucket / sub_buckets - 1);
+    uint64_t low = (sub_buckets + bucket % sub_buckets) << shift;
+    return low + ((uint64_t(1) << shift) - 1);
+}
+
+} // namespace latency_detail
+
+/**
+ * @brief A fixed-size histogram of nanosecond latencies with bounded relative error
+ */
+class Latency_Histogram {
+private:
+    std::vector<uint64_t> buckets;
+    uint64_t total;
+    uint64_t smallest;
+    uint64_t largest;
+    long double sum;
+
+public:
+    Latency_Histogram()
+        : buckets(latency_detail::bucket_count, 0), total(0), smallest(UINT64_MAX), largest(0), sum(0) {}
+
+    /**
+     * @brief Record one value
+     * @param nanoseconds The latency to record
+     */
+    void record(uint64_t nanoseconds) noexcept {
+        ++buckets[latency_detail::bucket_of(nanoseconds)];
+        ++total;
+        smallest = std::min(smallest, nanoseconds);
+        largest = std::max(largest, nanoseconds);
+        sum += static_cast<long double>(nanoseconds);
+    }
+
+    /**
+     * @brief Record the time from start until now
+     * @param start A steady_clock reading taken before the operation
+     */
+    void record_since(std::chrono::steady_clock::time_point start) noexcept {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    /**
+     * @brief Add every value recorded in another histogram, such as another thread's
+     * @param other The histogram to add
+     */
+    void merge(const Latency_Histogram& other) noexcept {
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            buckets[i] += other.buckets[i];
+        }
+        total += other.total;
+        smallest = std::min(smallest, other.smallest);
+        largest = std::max(largest, other.largest);
+        sum += other.sum;
+    }
+
+    /**
+     * @brief Forget every recorded value
+     */
+    void reset() noexcept {
+        std::fill(buckets.begin(), buckets.end(), 0);
+        total = 0;
+        smallest = UINT64_MAX;
+        largest = 0;
+        sum = 0;
+    }
+
+    [[nodiscard]] uint64_t count() const noexcept {
+        return total;
+    }
+
+    /**
+     * @brief Get the smallest recorded value, exactly; 0 if nothing was recorded
+     */
+    [[nodiscard]] uint64_t min() const noexcept {
+        return total == 0 ? 0 : smallest;
+    }
+
+    /**
+     * @brief Get the largest recorded value, exactly
+     */
+    [[nodiscard]] uint64_t max() const noexcept {
+        return largest;
+    }
+
+    [[nodiscard]] double mean() const noexcept {
+        return total == 0 ? 0.0 : static_cast<double>(sum / static_cast<long double>(total));
+    }
+
+    /**
+     * @brief Get the value that a given percentage of the recorded values are at or below
+     *
+     * The answer is the top of the bucket holding that rank, so it overstates
+     * the true value by less than 1/64 of it, and never exceeds max().
+     *
+     * @param percent From 0 to 100, such as 99.9
+     * @return The latency in nanoseconds; 0 if nothing was recorded
+     */
+    [[nodiscard]] uint64_t percentile(double percent) const noexcept {
+        if (total == 0) return 0;
+        double clamped = std::min(std::max(percent, 0.0), 100.0);
+        uint64_t rank = static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(total)));
+        rank = std::max<uint64_t>(rank, 1);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                return std::max(std::min(latency_detail::bucket_high(i), largest), smallest);
+            }
+        }
+        return largest;
+    }
+};
+
+/**
+ * @brief A queue whose enqueue and dequeue calls record their latency
+ * @tparam Queue Array_Queue or Linked_Queue
+ */
+template <class Queue>
+class Timed_Queue : public Queue {
+private:
+    Latency_Histogram enqueue_times;
+    Latency_Histogram dequeue_times;
+
+public:
+    using Queue::Queue;
+
+    template <class Item>
+    void enqueue(const Item& item) {
+        auto start = std::chrono::steady_clock::now();
+        Queue::enqueue(item);
+        enqueue_times.record_since(start);
+    }
+
+    void dequeue() {
+        auto start = std::chrono::steady_clock::now();
+        Queue::dequeue();
+        dequeue_times.record_since(start);
+    }
+
+    template <class Item>
+    void dequeue(Item& item) {
+        auto start = std::chrono::steady_clock::now();
+        Queue::dequeue(item);
+        dequeue_times.record_since(start);
+    }
+
+    [[nodiscard]] const Latency_Histogram& enqueue_latency() const noexcept {
+        return enqueue_times;
+    }
+
+    [[nodiscard]] const Latency_Histogram& dequeue_latency() const noexcept {
+        return dequeue_times;
+    }
+};
+
+/**
+ * @brief A stack whose push and pop calls record their latency
+ * @tparam Stack Linked_Stack or a type with the same push and pop
+ */
+template <class Stack>
+class Timed_Stack : public Stack {
+private:
+    Latency_Histogram push_times;
+    Latency_Histogram pop_times;
+
+public:
+    using Stack::Stack;
+
+    template <class Item>
+    void push(const Item& item) {
+        auto start = std::chrono::steady_clock::now();
+        Stack::push(item);
+        push_times.record_since(start);
+    }
+
+    void pop() {
+        auto start = std::chrono::steady_clock::now();
+        Stack::pop();
+        pop_times.record_since(start);
+    }
+
+    template <class Item>
+    void pop(Item& item) {
+        auto start = std::chrono::steady_clock::now();
+        Stack::pop(item);
+        pop_times.record_since(start);
+    }
+
+    [[nodiscard]] const Latency_Histogram& push_latency() const noexcept {
+        return push_times;
+    }
+
+    [[nodiscard]] const Latency_Histogram& pop_latency() const noexcept {
+        return pop_times;
+    }
+};
+
+#endif // LATENCY_HISTOGRAM_H
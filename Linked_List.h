@@ -12,13 +12,17 @@
 #include <iostream>
 #include <stdexcept>
 #include <iterator>
+#include <vector>
+
+#include "Memory_Stats.h"
+#include "Radix_Sort.h"
 
 /**
  * @brief A template-based singly linked list implementation
  * @tparam T The type of elements stored in the list
  */
 template <class T>
-class Single_Linked_List {
+class Single_Linked_List : public Memory_Tracked<Single_Linked_List<T>> {
 private:
     /**
      * @brief Node structure for the singly linked list
@@ -42,6 +46,9 @@ public:
     using const_reference = const T&;
     using size_type = size_t;
 
+    /// Name the node allocations are counted under, see Memory_Stats.h
+    static constexpr const char* memory_name = "Single_Linked_List";
+
     /**
      * @brief Default constructor
      */
@@ -51,7 +58,8 @@ public:
      * @brief Copy constructor
      * @param other The list to copy from
      */
-    Single_Linked_List(const Single_Linked_List& other) : head(nullptr), tail(nullptr), length(0) {
+    Single_Linked_List(const Single_Linked_List& other)
+        : Memory_Tracked<Single_Linked_List<T>>(), head(nullptr), tail(nullptr), length(0) {
         Node* temp = other.head;
         while (temp != nullptr) {
             push_back(temp->item);
@@ -63,8 +71,8 @@ public:
      * @brief Move constructor
      * @param other The list to move from
      */
-    Single_Linked_List(Single_Linked_List&& other) noexcept 
-        : head(other.head), tail(other.tail), length(other.length) {
+    Single_Linked_List(Single_Linked_List&& other) noexcept
+        : Memory_Tracked<Single_Linked_List<T>>(std::move(other)), head(other.head), tail(other.tail), length(other.length) {
         other.head = nullptr;
         other.tail = nullptr;
         other.length = 0;
@@ -95,6 +103,7 @@ public:
     Single_Linked_List& operator=(Single_Linked_List&& other) noexcept {
         if (this != &other) {
             clear();
+            this->adopt_memory(other);
             head = other.head;
             tail = other.tail;
             length = other.length;
@@ -133,7 +142,7 @@ public:
      * @param value The value to add
      */
     void push_back(const T& value) {
-        Node* new_node = new Node(value);
+        Node* new_node = this->template allocate_node<Node>(value);
         if (empty()) {
             head = tail = new_node;
         } else {
@@ -148,7 +157,7 @@ public:
      * @param value The value to add
      */
     void push_back(T&& value) {
-        Node* new_node = new Node(std::move(value));
+        Node* new_node = this->template allocate_node<Node>(std::move(value));
         if (empty()) {
             head = tail = new_node;
         } else {
@@ -163,7 +172,7 @@ public:
      * @param value The value to add
      */
     void push_front(const T& value) {
-        Node* new_node = new Node(value);
+        Node* new_node = this->template allocate_node<Node>(value);
         if (empty()) {
             head = tail = new_node;
         } else {
@@ -178,7 +187,7 @@ public:
      * @param value The value to add
      */
     void push_front(T&& value) {
-        Node* new_node = new Node(std::move(value));
+        Node* new_node = this->template allocate_node<Node>(std::move(value));
         if (empty()) {
             head = tail = new_node;
         } else {
@@ -204,7 +213,7 @@ public:
         } else if (index == length) {
             push_back(value);
         } else {
-            Node* new_node = new Node(value);
+            Node* new_node = this->template allocate_node<Node>(value);
             Node* temp = head;
             for (size_t i = 0; i < index - 1; ++i) {
                 temp = temp->next;
@@ -228,7 +237,7 @@ public:
         if (head == nullptr) {
             tail = nullptr;
         }
-        delete temp;
+        this->free_node(temp);
         --length;
     }
 
@@ -241,14 +250,14 @@ public:
             throw std::runtime_error("List is empty in pop_back()");
         }
         if (head == tail) {
-            delete head;
+            this->free_node(head);
             head = tail = nullptr;
         } else {
             Node* temp = head;
             while (temp->next != tail) {
                 temp = temp->next;
             }
-            delete tail;
+            this->free_node(tail);
             tail = temp;
             tail->next = nullptr;
         }
@@ -276,7 +285,7 @@ public:
             }
             Node* to_delete = temp->next;
             temp->next = to_delete->next;
-            delete to_delete;
+            this->free_node(to_delete);
             --length;
         }
     }
@@ -326,6 +335,40 @@ public:
         return static_cast<size_t>(-1);
     }
 
+    /**
+     * @brief Stable sort by an integer or floating-point key
+     *
+     * The node pointers are copied into an array, radix sorted there by key and
+     * relinked, so no element is copied or moved.
+     *
+     * @param key Callable taking const T& and returning the key
+     */
+    template <class Key>
+    void radix_sort(Key key) {
+        if (length < 2) {
+            return;
+        }
+        std::vector<Node*> nodes;
+        nodes.reserve(length);
+        for (Node* temp = head; temp != nullptr; temp = temp->next) {
+            nodes.push_back(temp);
+        }
+        ::radix_sort(nodes.data(), nodes.size(), [&key](const Node* node) { return key(node->item); });
+        head = nodes.front();
+        for (size_t i = 1; i < nodes.size(); ++i) {
+            nodes[i - 1]->next = nodes[i];
+        }
+        tail = nodes.back();
+        tail->next = nullptr;
+    }
+
+    /**
+     * @brief Sort a list of integer or floating-point values in ascending order
+     */
+    void radix_sort() {
+        radix_sort([](const T& value) { return value; });
+    }
+
     /**
      * @brief Print the list contents to standard output
      */
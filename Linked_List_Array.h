@@ -5,16 +5,42 @@
 #ifndef LINKED_LIST_ARRAY_H
 #define LINKED_LIST_ARRAY_H
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
 using namespace std;
 
 
 template <class t>
 class Array {
-    int max_size;
-    int* arr;
-    int length;
+    size_t max_size;
+    t* arr;
+    size_t length;
+
+    // Move [from, length) up by count slots. Caller guarantees the room.
+    void shift_right(size_t from, size_t count) {
+        if constexpr (is_trivially_copyable<t>::value) {
+            memmove(arr + from + count, arr + from, (length - from) * sizeof(t));
+        }
+        else {
+            move_backward(arr + from, arr + length, arr + length + count);
+        }
+    }
+
+    // Move [from, length) down by count slots, overwriting the gap before it.
+    void shift_left(size_t from, size_t count) {
+        if constexpr (is_trivially_copyable<t>::value) {
+            memmove(arr + from - count, arr + from, (length - from) * sizeof(t));
+        }
+        else {
+            move(arr + from, arr + length, arr + from - count);
+        }
+    }
+
 public:
-    Array(size_t size):max_size(size), arr(new t), length(0) {}
+    Array(size_t size):max_size(size), arr(new t[size]), length(0) {}
 
     bool empty() {
         return length ==0;
@@ -24,10 +50,18 @@ public:
         return length == max_size;
     }
 
-    int get_length() {
+    size_t get_length() {
         return length;
     }
 
+    t* data() {
+        return arr;
+    }
+
+    const t* data() const {
+        return arr;
+    }
+
     void print() const {
         cout << "[ ";
         for (size_t i = 0; i < length; ++i) {
@@ -48,9 +82,7 @@ public:
 
     void push_front (t value) {
         if (!full()) {
-            for (size_t i = length; i > 0; --i) {
-                arr[i] = arr[i - 1];
-            }
+            shift_right(0, 1);
             arr[0] = value;
             ++length;
         }
@@ -61,9 +93,7 @@ public:
 
     void insert (size_t pos, t value) {
         if (!full() && pos <= length ) {
-            for (size_t i = length; i > pos; --i) {
-                arr[i] = arr[i - 1];
-            }
+            shift_right(pos, 1);
             arr[pos] = value;
             ++length;
         }
@@ -75,18 +105,61 @@ public:
         }
     }
 
-    void erase(size_t pos) {
-        if (!empty() && pos <= length ) {
-            for (size_t i = pos; i < length; ++i) {
-                arr[i] = arr[i + 1];
+    // Inserts [first, last) before pos, shifting the tail once for the whole range.
+    // The range is walked twice, so it has to be a forward range; it may come
+    // from this array's own data().
+    template <class ForwardIt, class = enable_if_t<is_base_of<forward_iterator_tag,
+                                   typename iterator_traits<ForwardIt>::iterator_category>::value>>
+    void insert (size_t pos, ForwardIt first, ForwardIt last) {
+        size_t count = static_cast<size_t>(distance(first, last));
+        if (pos > length) {
+            cout << "Out of range in Insert" << endl;
+        }
+        else if (count > max_size - length) {
+            cout << "Array is full at Insert" << endl;
+        }
+        else {
+            if constexpr (is_pointer<ForwardIt>::value && is_same<remove_cv_t<remove_pointer_t<ForwardIt>>, t>::value) {
+                less<const t*> before;
+                if (before(first, arr + length) && before(arr, last)) {
+                    // The part of the range at or after pos moves up with the tail
+                    size_t from = static_cast<size_t>(first - arr);
+                    size_t to = static_cast<size_t>(last - arr);
+                    size_t split = clamp(pos, from, to);
+                    shift_right(pos, count);
+                    t* out = copy(arr + from, arr + split, arr + pos);
+                    copy(arr + split + count, arr + to + count, out);
+                    length += count;
+                    return;
+                }
             }
+            shift_right(pos, count);
+            copy(first, last, arr + pos);
+            length += count;
+        }
+    }
+
+    void erase(size_t pos) {
+        if (!empty() && pos < length ) {
+            shift_left(pos + 1, 1);
             --length;
         }
-        else if (pos > length) {
-            cout << "Out of range in Insert At" << endl;
+        else if (!empty()) {
+            cout << "Out of range in Erase" << endl;
+        }
+        else {
+            cout << "Array is empty at Erase" << endl;
+        }
+    }
+
+    // Erases [first, last), shifting the tail once for the whole range.
+    void erase(size_t first, size_t last) {
+        if (first <= last && last <= length) {
+            shift_left(last, last - first);
+            length -= last - first;
         }
         else {
-            cout << "Array is empty at Insert At" << endl;
+            cout << "Out of range in Erase" << endl;
         }
     }
 
@@ -95,6 +168,7 @@ public:
             return arr[pos];
         }
         cout << "Out of range in Insert At" << endl;
+        return t();
     }
 
     void update_at (size_t pos, t val) {
@@ -7,11 +7,12 @@
 #include <assert.h>
 #include <iostream>
 #include <string>
+#include "Memory_Stats.h"
 
 using namespace std;
 
 template <class t>
-class Queue {
+class Linked_Queue : public Memory_Tracked<Linked_Queue<t>> {
 private:
     struct node {
         t item;
@@ -23,7 +24,16 @@ private:
     long long length;
 
 public:
-    Queue(): front(nullptr), rear(nullptr), length(0) {};
+    static constexpr const char* memory_name = "Linked_Queue";
+
+    Linked_Queue(): front(nullptr), rear(nullptr), length(0) {};
+
+    Linked_Queue(const Linked_Queue&) = delete;
+    Linked_Queue& operator=(const Linked_Queue&) = delete;
+
+    ~Linked_Queue() {
+        clear();
+    }
 
     bool empty() {
         return length == 0;
@@ -31,14 +41,14 @@ public:
 
     void enqueue(t new_item) {
         if (empty()) {
-            front = new node;
+            front = this->template allocate_node<node>();
             front -> item = new_item;
             front -> next = nullptr;
             rear = front;
             ++length;
         }
         else {
-            node* temp = new node;
+            node* temp = this->template allocate_node<node>();
             temp -> item = new_item;
             temp -> next = nullptr;
             rear -> next = temp;
@@ -49,7 +59,10 @@ public:
 
     void dequeue () {
         if (!empty()) {
+            node* temp = front;
             front = front -> next;
+            this->free_node(temp);
+            --length;
         }
         else {
             cout << "Queue is empty at Dequeue!" << endl;
@@ -62,7 +75,7 @@ public:
             node* temp = front;
             front = front -> next;
             temp -> next = nullptr;
-            delete temp;
+            this->free_node(temp);
             --length;
         }
         else {
@@ -101,7 +114,6 @@ public:
             temp = temp -> next;
         }
         cout << "]" << endl;
-        delete temp;
     }
 };
 
@@ -6,10 +6,11 @@
 #define LINKED_STACK_H
 
 #include <iostream>
+#include "Memory_Stats.h"
 using namespace std;
 
 template <class t>
-class Stack {
+class Linked_Stack : public Memory_Tracked<Linked_Stack<t>> {
 private:
     struct node {
         t item;
@@ -20,10 +21,19 @@ private:
     long long length;
 
 public:
-    Stack(): top(nullptr), length(0) {}
+    static constexpr const char* memory_name = "Linked_Stack";
+
+    Linked_Stack(): top(nullptr), length(0) {}
+
+    Linked_Stack(const Linked_Stack&) = delete;
+    Linked_Stack& operator=(const Linked_Stack&) = delete;
+
+    ~Linked_Stack() {
+        clear();
+    }
 
     void push(t new_item) {
-        node *new_itemPtr = new node;
+        node *new_itemPtr = this->template allocate_node<node>();
 
         if (new_itemPtr != nullptr) {
             new_itemPtr -> item = new_item;
@@ -44,8 +54,7 @@ public:
         if (!empty()) {
             node *temp = top;
             top = top -> next;
-            temp = temp -> next = nullptr;
-            delete temp;
+            this->free_node(temp);
             --length;
         }
         else {
@@ -58,8 +67,7 @@ public:
             item_copy = top -> item;
             node *temp = top;
             top = top -> next;
-            temp = temp -> next = nullptr;
-            delete temp;
+            this->free_node(temp);
             --length;
         }
         else {
@@ -67,6 +75,12 @@ public:
         }
     }
 
+    void clear() {
+        while (!empty()) {
+            pop();
+        }
+    }
+
     t get_top() {
         if (top != nullptr) {
             return top -> item;
@@ -85,7 +99,6 @@ public:
             temp = temp -> next;
         }
         cout << "]" << endl;
-        delete temp;
     }
 
 };
@@ -0,0 +1,387 @@
+/**
+ * @file Mapped_Array.h
+ * @brief A persistent array of trivially copyable elements backed by a memory-mapped file
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ */
+
+#ifndef MAPPED_ARRAY_H
+#define MAPPED_ARRAY_H
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief How a Mapped_Array opens its file
+ */
+enum class Map_Mode {
+    read_only,  ///< Map an existing file read-only; any number of processes may share it
+    read_write  ///< Map the file read-write, creating it when it does not exist
+};
+
+/**
+ * @brief An array whose elements live in a memory-mapped file
+ *
+ * The file starts with a 64-byte header (magic, format version, element size,
+ * length and capacity) followed by the elements. Reopening a file validates
+ * the header and maps it, so a table built once is paged in on demand instead
+ * of being rebuilt. Growth extends the file with ftruncate() and remaps it
+ * with mremap() where available.
+ *
+ * @tparam T The type of elements stored in the array; must be trivially copyable
+ */
+template <class T>
+class Mapped_Array {
+private:
+    static_assert(std::is_trivially_copyable<T>::value, "Mapped_Array requires a trivially copyable type");
+    static_assert(alignof(T) <= 64, "Mapped_Array elements must fit the header alignment");
+
+    struct Header {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t element_size;
+        std::uint64_t length;
+        std::uint64_t capacity;
+    };
+
+    static constexpr char file_magic[8] = {'D', 'S', 'M', 'A', 'P', 'A', 'R', 'R'};
+    static constexpr std::uint32_t format_version = 1;
+    static constexpr size_t header_bytes = 64;
+    static_assert(sizeof(Header) <= header_bytes, "Mapped_Array header does not fit");
+
+    int fd;
+    void* base;
+    size_t mapped_bytes;
+    Map_Mode mode;
+
+    Header* header() const noexcept {
+        return static_cast<Header*>(base);
+    }
+
+    // Null once the mapping has been moved away
+    T* items() const noexcept {
+        if (base == nullptr) return nullptr;
+        return reinterpret_cast<T*>(static_cast<char*>(base) + header_bytes);
+    }
+
+    static size_t bytes_for(size_t capacity) noexcept {
+        return header_bytes + capacity * sizeof(T);
+    }
+
+    [[noreturn]] static void fail(const std::string& what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    void map(size_t bytes) {
+        int protection = mode == Map_Mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+        void* address = ::mmap(nullptr, bytes, protection, MAP_SHARED, fd, 0);
+        if (address == MAP_FAILED) {
+            fail("mmap failed in Mapped_Array");
+        }
+        base = address;
+        mapped_bytes = bytes;
+    }
+
+    void unmap() noexcept {
+        if (base != nullptr) {
+            ::munmap(base, mapped_bytes);
+            base = nullptr;
+            mapped_bytes = 0;
+        }
+    }
+
+    void validate(size_t file_bytes) const {
+        const Header* h = header();
+        if (std::memcmp(h->magic, file_magic, sizeof(file_magic)) != 0) {
+            throw std::runtime_error("Not a Mapped_Array file");
+        }
+        if (h->version != format_version) {
+            throw std::runtime_error("Unsupported Mapped_Array format version");
+        }
+        if (h->element_size != sizeof(T)) {
+            throw std::runtime_error("Element size mismatch in Mapped_Array file");
+        }
+        if (h->length > h->capacity || bytes_for(h->capacity) > file_bytes) {
+            throw std::runtime_error("Corrupt Mapped_Array header");
+        }
+    }
+
+    void close_file() noexcept {
+        unmap();
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+public:
+    // Type definitions for STL compatibility
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+
+    /**
+     * @brief Open or create a mapped array
+     * @param path The backing file
+     * @param mode read_only to share an existing table, read_write to build or update one
+     * @param initial_capacity Elements to reserve when the file is created
+     * @throw std::system_error if the file cannot be opened, resized or mapped
+     * @throw std::runtime_error if an existing file has an incompatible header
+     */
+    explicit Mapped_Array(const std::string& path, Map_Mode mode = Map_Mode::read_write,
+                          size_t initial_capacity = 1024)
+        : fd(-1), base(nullptr), mapped_bytes(0), mode(mode) {
+        fd = mode == Map_Mode::read_only ? ::open(path.c_str(), O_RDONLY)
+                                         : ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            fail("Cannot open " + path);
+        }
+        try {
+            struct stat info {};
+            if (::fstat(fd, &info) != 0) {
+                fail("fstat failed in Mapped_Array");
+            }
+            size_t file_bytes = static_cast<size_t>(info.st_size);
+            if (file_bytes == 0 && mode == Map_Mode::read_write) {
+                initial_capacity = std::max<size_t>(initial_capacity, 1);
+                file_bytes = bytes_for(initial_capacity);
+                if (::ftruncate(fd, static_cast<off_t>(file_bytes)) != 0) {
+                    fail("ftruncate failed in Mapped_Array");
+                }
+                map(file_bytes);
+                Header* h = header();
+                std::memcpy(h->magic, file_magic, sizeof(file_magic));
+                h->version = format_version;
+                h->element_size = sizeof(T);
+                h->length = 0;
+                h->capacity = initial_capacity;
+            } else {
+                if (file_bytes < header_bytes) {
+                    throw std::runtime_error("Not a Mapped_Array file: " + path);
+                }
+                map(file_bytes);
+                validate(file_bytes);
+            }
+        } catch (...) {
+            close_file();
+            throw;
+        }
+    }
+
+    Mapped_Array(const Mapped_Array&) = delete;
+    Mapped_Array& operator=(const Mapped_Array&) = delete;
+
+    /**
+     * @brief Move constructor
+     * @param other The array to move from, left empty with no file
+     */
+    Mapped_Array(Mapped_Array&& other) noexcept
+        : fd(other.fd), base(other.base), mapped_bytes(other.mapped_bytes), mode(other.mode) {
+        other.fd = -1;
+        other.base = nullptr;
+        other.mapped_bytes = 0;
+    }
+
+    /**
+     * @brief Move assignment operator
+     * @param other The array to move from
+     * @return Reference to this array
+     */
+    Mapped_Array& operator=(Mapped_Array&& other) noexcept {
+        if (this != &other) {
+            close_file();
+            fd = other.fd;
+            base = other.base;
+            mapped_bytes = other.mapped_bytes;
+            mode = other.mode;
+            other.fd = -1;
+            other.base = nullptr;
+            other.mapped_bytes = 0;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destructor; unmaps the file without forcing it to disk
+     */
+    ~Mapped_Array() {
+        close_file();
+    }
+
+    /**
+     * @brief Check if the array is empty
+     * @return true if the array is empty, false otherwise
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return get_length() == 0;
+    }
+
+    /**
+     * @brief Get the number of stored elements
+     * @return The length recorded in the file header, limited to what this mapping covers
+     *         (a reader does not see elements a writer appended after it opened the file);
+     *         0 once moved from
+     */
+    [[nodiscard]] size_t get_length() const noexcept {
+        if (base == nullptr) return 0;
+        return std::min(static_cast<size_t>(header()->length), (mapped_bytes - header_bytes) / sizeof(T));
+    }
+
+    /**
+     * @brief Get the number of elements that fit before the file has to grow
+     * @return The capacity recorded in the file header; 0 once moved from
+     */
+    [[nodiscard]] size_t get_capacity() const noexcept {
+        if (base == nullptr) return 0;
+        return static_cast<size_t>(header()->capacity);
+    }
+
+    /**
+     * @brief Check whether the array was opened read-only
+     */
+    [[nodiscard]] bool read_only() const noexcept {
+        return mode == Map_Mode::read_only;
+    }
+
+    T* data() noexcept {
+        return items();
+    }
+
+    const T* data() const noexcept {
+        return items();
+    }
+
+    /**
+     * @brief Grow the file so it holds at least capacity elements
+     * @param capacity The minimum capacity
+     * @throw std::logic_error if the array is read-only
+     * @throw std::system_error if the file cannot be resized or remapped
+     */
+    void reserve(size_t capacity) {
+        if (read_only()) {
+            throw std::logic_error("Mapped_Array is read-only in reserve()");
+        }
+        if (capacity <= get_capacity()) return;
+        size_t new_bytes = bytes_for(capacity);
+        if (::ftruncate(fd, static_cast<off_t>(new_bytes)) != 0) {
+            fail("ftruncate failed in Mapped_Array");
+        }
+#ifdef MREMAP_MAYMOVE
+        void* address = ::mremap(base, mapped_bytes, new_bytes, MREMAP_MAYMOVE);
+        if (address == MAP_FAILED) {
+            fail("mremap failed in Mapped_Array");
+        }
+        base = address;
+        mapped_bytes = new_bytes;
+#else
+        unmap();
+        map(new_bytes);
+#endif
+        header()->capacity = capacity;
+    }
+
+    /**
+     * @brief Add an element to the end of the array, growing the file when needed
+     * @param value The value to add
+     * @throw std::logic_error if the array is read-only
+     */
+    void push_back(const T& value) {
+        if (read_only()) {
+            throw std::logic_error("Mapped_Array is read-only in push_back()");
+        }
+        size_t length = get_length();
+        if (length == get_capacity()) {
+            T copy = value;
+            reserve(std::max<size_t>(length * 2, 1));
+            items()[length] = copy;
+        } else {
+            items()[length] = value;
+        }
+        header()->length = length + 1;
+    }
+
+    /**
+     * @brief Access an element by index
+     * @param pos The position of the element
+     * @return Copy of the element
+     * @throw std::out_of_range if pos is out of range
+     */
+    [[nodiscard]] T at(size_t pos) const {
+        if (pos >= get_length()) {
+            throw std::out_of_range("Index out of range in at()");
+        }
+        return items()[pos];
+    }
+
+    /**
+     * @brief Replace the element at a specific position
+     * @param pos The position of the element
+     * @param value The new value
+     * @throw std::out_of_range if pos is out of range
+     * @throw std::logic_error if the array is read-only
+     */
+    void update_at(size_t pos, const T& value) {
+        if (read_only()) {
+            throw std::logic_error("Mapped_Array is read-only in update_at()");
+        }
+        if (pos >= get_length()) {
+            throw std::out_of_range("Index out of range in update_at()");
+        }
+        items()[pos] = value;
+    }
+
+    /**
+     * @brief Remove all elements; the file keeps its size
+     * @throw std::logic_error if the array is read-only
+     */
+    void clear() {
+        if (read_only()) {
+            throw std::logic_error("Mapped_Array is read-only in clear()");
+        }
+        if (base != nullptr) {
+            header()->length = 0;
+        }
+    }
+
+    /**
+     * @brief Write dirty pages back to the file
+     * @param wait true to block until the data is on disk (MS_SYNC), false to schedule it (MS_ASYNC)
+     * @throw std::system_error if msync fails
+     */
+    void flush(bool wait = true) {
+        if (::msync(base, mapped_bytes, wait ? MS_SYNC : MS_ASYNC) != 0) {
+            fail("msync failed in Mapped_Array");
+        }
+    }
+
+    /**
+     * @brief Print the array contents to standard output
+     */
+    void print() const {
+        std::cout << "[ ";
+        for (size_t i = 0; i < get_length(); ++i) {
+            std::cout << items()[i] << ' ';
+        }
+        std::cout << ']' << std::endl;
+    }
+};
+
+#endif // defined(__unix__) || defined(__APPLE__)
+
+#endif // MAPPED_ARRAY_H
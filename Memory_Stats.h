@@ -0,0 +1,255 @@
+/**
+ * @file Memory_Stats.h
+ * @brief Opt-in counting of node allocations per container type and per container
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * The node-based containers allocate and free their nodes through
+ * Memory_Tracked, which they inherit from. Define DS_TRACK_ALLOCATIONS for
+ * the whole program (or configure CMake with -DDS_TRACK_ALLOCATIONS=ON) to
+ * count allocations, frees, live bytes and peak bytes for every container
+ * and for every container type. Without it Memory_Tracked is an empty base
+ * class, allocation is a plain new and delete, and the stats are all zero,
+ * so the containers are exactly as large and as fast as before.
+ */
+
+#ifndef MEMORY_STATS_H
+#define MEMORY_STATS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(DS_TRACK_ALLOCATIONS)
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#endif
+
+/**
+ * @brief Node allocation counters of one container or one container type
+ */
+struct Memory_Stats {
+    size_t allocations = 0;
+    size_t frees = 0;
+    size_t live_bytes = 0;
+    size_t peak_bytes = 0;
+};
+
+namespace memory_detail {
+
+#if defined(DS_TRACK_ALLOCATIONS)
+
+// Counters shared by every container of one type, which may live on different threads
+struct Type_Counters {
+    const char* name;
+    std::atomic<size_t> allocations{0};
+    std::atomic<size_t> frees{0};
+    std::atomic<size_t> live_bytes{0};
+    std::atomic<size_t> peak_bytes{0};
+
+    explicit Type_Counters(const char* type_name) : name(type_name) {}
+
+    void allocate(size_t bytes) noexcept {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        size_t live = live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        size_t peak = peak_bytes.load(std::memory_order_relaxed);
+        while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    void free(size_t bytes) noexcept {
+        frees.fetch_add(1, std::memory_order_relaxed);
+        live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    Memory_Stats snapshot() const noexcept {
+        Memory_Stats stats;
+        stats.allocations = allocations.load(std::memory_order_relaxed);
+        stats.frees = frees.load(std::memory_order_relaxed);
+        stats.live_bytes = live_bytes.load(std::memory_order_relaxed);
+        stats.peak_bytes = peak_bytes.load(std::memory_order_relaxed);
+        return stats;
+    }
+};
+
+// Every type that has been used, in first-use order; a deque never moves its elements
+struct Registry {
+    std::mutex mutex;
+    std::deque<Type_Counters> types;
+};
+
+inline Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// Each container type looks its counters up once and keeps the reference
+inline Type_Counters& counters_for(const char* name) {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    for (Type_Counters& counters : shared.types) {
+        if (std::strcmp(counters.name, name) == 0) return counters;
+    }
+    shared.types.emplace_back(name);
+    return shared.types.back();
+}
+
+#endif // defined(DS_TRACK_ALLOCATIONS)
+
+} // namespace memory_detail
+
+/**
+ * @brief Base class that allocates a container's nodes and counts them when tracking is on
+ *
+ * Every instantiation of a container template shares the counters of its
+ * memory_name, so Single_Linked_List<int> and Single_Linked_List<double> are
+ * reported together. Moving a container moves its counters along with its nodes.
+ *
+ * @tparam Container The derived container, which defines a static memory_name
+ */
+template <class Container>
+class Memory_Tracked {
+#if defined(DS_TRACK_ALLOCATIONS)
+private:
+    Memory_Stats instance;
+
+    static memory_detail::Type_Counters& type_counters() {
+        static memory_detail::Type_Counters& counters = memory_detail::counters_for(Container::memory_name);
+        return counters;
+    }
+#endif
+
+protected:
+    Memory_Tracked() noexcept = default;
+
+    // A copy allocates its own nodes, so it starts from zero
+    Memory_Tracked(const Memory_Tracked&) noexcept {}
+
+    Memory_Tracked(Memory_Tracked&& other) noexcept {
+        adopt_memory(other);
+    }
+
+    Memory_Tracked& operator=(const Memory_Tracked&) noexcept {
+        return *this;
+    }
+
+    Memory_Tracked& operator=(Memory_Tracked&& other) noexcept {
+        adopt_memory(other);
+        return *this;
+    }
+
+    ~Memory_Tracked() = default;
+
+    /**
+     * @brief Take over the counters of a container whose nodes this one has taken
+     * @param other The moved-from container, left with zero counters
+     */
+    void adopt_memory([[maybe_unused]] Memory_Tracked& other) noexcept {
+#if defined(DS_TRACK_ALLOCATIONS)
+        if (this != &other) {
+            instance = other.instance;
+            other.instance = Memory_Stats();
+        }
+#endif
+    }
+
+    /**
+     * @brief Allocate and construct one node
+     * @tparam Node The container's node type
+     * @param args Arguments for the node's constructor
+     * @return The new node
+     */
+    template <class Node, class... Args>
+    Node* allocate_node(Args&&... args) {
+        Node* node = new Node(std::forward<Args>(args)...);
+#if defined(DS_TRACK_ALLOCATIONS)
+        instance.allocations += 1;
+        instance.live_bytes += sizeof(Node);
+        instance.peak_bytes = std::max(instance.peak_bytes, instance.live_bytes);
+        type_counters().allocate(sizeof(Node));
+#endif
+        return node;
+    }
+
+    /**
+     * @brief Destroy and free one node from allocate_node()
+     * @param node The node, which must not be null
+     */
+    template <class Node>
+    void free_node(Node* node) noexcept {
+        delete node;
+#if defined(DS_TRACK_ALLOCATIONS)
+        instance.frees += 1;
+        instance.live_bytes -= sizeof(Node);
+        type_counters().free(sizeof(Node));
+#endif
+    }
+
+public:
+    /**
+     * @brief Get this container's node allocation counters; all zero unless DS_TRACK_ALLOCATIONS is defined
+     */
+    [[nodiscard]] Memory_Stats memory_stats() const noexcept {
+#if defined(DS_TRACK_ALLOCATIONS)
+        return instance;
+#else
+        return Memory_Stats();
+#endif
+    }
+
+    /**
+     * @brief Get the counters of every container of this type together
+     */
+    [[nodiscard]] static Memory_Stats type_memory_stats() noexcept {
+#if defined(DS_TRACK_ALLOCATIONS)
+        return type_counters().snapshot();
+#else
+        return Memory_Stats();
+#endif
+    }
+};
+
+/**
+ * @brief Get the counters of every container type used so far, by name
+ * @return One entry per type in first-use order; empty unless DS_TRACK_ALLOCATIONS is defined
+ */
+inline std::vector<std::pair<std::string, Memory_Stats>> memory_stats_by_type() {
+    std::vector<std::pair<std::string, Memory_Stats>> result;
+#if defined(DS_TRACK_ALLOCATIONS)
+    memory_detail::Registry& shared = memory_detail::registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    for (const memory_detail::Type_Counters& counters : shared.types) {
+        result.emplace_back(counters.name, counters.snapshot());
+    }
+#endif
+    return result;
+}
+
+/**
+ * @brief Print a table of memory_stats_by_type()
+ * @param out The stream to print to
+ */
+inline void print_memory_stats(std::ostream& out) {
+#if defined(DS_TRACK_ALLOCATIONS)
+    out << std::left << std::setw(22) << "container" << std::right << std::setw(14) << "allocations"
+        << std::setw(14) << "frees" << std::setw(14) << "live bytes" << std::setw(14) << "peak bytes" << '\n';
+    for (const auto& entry : memory_stats_by_type()) {
+        const Memory_Stats& stats = entry.second;
+        out << std::left << std::setw(22) << entry.first << std::right << std::setw(14) << stats.allocations
+            << std::setw(14) << stats.frees << std::setw(14) << stats.live_bytes << std::setw(14)
+            << stats.peak_bytes << '\n';
+    }
+#else
+    out << "Allocation tracking is off; build with DS_TRACK_ALLOCATIONS to count node allocations\n";
+#endif
+    out.flush();
+}
+
+#endif // MEMORY_STATS_H
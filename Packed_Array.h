@@ -0,0 +1,415 @@
+/**
+ * @file Packed_Array.h
+ * @brief A read-only integer array compressed by bit-packing in fixed-size blocks
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ */
+
+#ifndef PACKED_ARRAY_H
+#define PACKED_ARRAY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Linked_List_Array.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DS_PACKED_AVX2 1
+#include <immintrin.h>
+#else
+#define DS_PACKED_AVX2 0
+#endif
+
+/**
+ * @brief How a Packed_Array encodes each block before bit-packing it
+ */
+enum class Pack_Encoding {
+    plain,              ///< Values as-is (zigzag-mapped for signed types)
+    frame_of_reference, ///< Offsets from the block minimum
+    delta               ///< Zigzag-mapped differences from the previous value
+};
+
+/**
+ * @brief An immutable integer array stored as bit-packed blocks
+ *
+ * Values are split into blocks of block_size. Each block keeps a reference
+ * value and a bit width, and its values are packed at that width into a shared
+ * word stream. The width is either fixed by the caller or, by default, the
+ * smallest that fits each block. at(i) unpacks one field in O(1) (delta blocks
+ * add up at most block_size differences); decode_block() unpacks a whole block
+ * with AVX2 gathers when the CPU supports it.
+ *
+ * @tparam T An integral type of at most 64 bits
+ */
+template <class T>
+class Packed_Array {
+private:
+    static_assert(std::is_integral<T>::value && sizeof(T) <= 8, "Packed_Array requires an integral type of at most 64 bits");
+
+public:
+    static constexpr size_t block_size = 128;
+
+private:
+    struct Block {
+        std::uint64_t reference;
+        std::uint64_t bit_offset;
+        unsigned width;
+    };
+
+    std::vector<std::uint64_t> words;
+    std::vector<Block> blocks;
+    size_t length;
+    Pack_Encoding encoding;
+
+    static std::uint64_t raw(T value) noexcept {
+        if constexpr (std::is_signed<T>::value) {
+            return static_cast<std::uint64_t>(static_cast<std::int64_t>(value));
+        } else {
+            return static_cast<std::uint64_t>(value);
+        }
+    }
+
+    static std::uint64_t zigzag(std::uint64_t value) noexcept {
+        return (value << 1) ^ (0 - (value >> 63));
+    }
+
+    static std::uint64_t unzigzag(std::uint64_t value) noexcept {
+        return (value >> 1) ^ (0 - (value & 1));
+    }
+
+    static unsigned bits_needed(std::uint64_t value) noexcept {
+        unsigned bits = 0;
+        while (value != 0) {
+            ++bits;
+            value >>= 1;
+        }
+        return bits;
+    }
+
+    static std::uint64_t mask(unsigned width) noexcept {
+        return width >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+    }
+
+    void put(std::uint64_t bit, std::uint64_t value, unsigned width) {
+        size_t word = static_cast<size_t>(bit / 64);
+        unsigned shift = static_cast<unsigned>(bit % 64);
+        words[word] |= value << shift;
+        if (shift + width > 64) {
+            words[word + 1] |= value >> (64 - shift);
+        }
+    }
+
+    std::uint64_t get(std::uint64_t bit, unsigned width) const noexcept {
+        if (width == 0) return 0;
+        size_t word = static_cast<size_t>(bit / 64);
+        unsigned shift = static_cast<unsigned>(bit % 64);
+        std::uint64_t value = words[word] >> shift;
+        if (shift + width > 64) {
+            value |= words[word + 1] << (64 - shift);
+        }
+        return value & mask(width);
+    }
+
+    // Turns one block's values into the unsigned codes that get bit-packed
+    std::uint64_t encode_block(const T* values, size_t count, std::uint64_t* codes) const {
+        std::uint64_t reference = 0;
+        switch (encoding) {
+            case Pack_Encoding::plain:
+                for (size_t i = 0; i < count; ++i) {
+                    codes[i] = std::is_signed<T>::value ? zigzag(raw(values[i])) : raw(values[i]);
+                }
+                break;
+            case Pack_Encoding::frame_of_reference:
+                reference = raw(*std::min_element(values, values + count));
+                for (size_t i = 0; i < count; ++i) {
+                    codes[i] = raw(values[i]) - reference;
+                }
+                break;
+            case Pack_Encoding::delta:
+                reference = raw(values[0]);
+                codes[0] = 0;
+                for (size_t i = 1; i < count; ++i) {
+                    codes[i] = zigzag(raw(values[i]) - raw(values[i - 1]));
+                }
+                break;
+        }
+        return reference;
+    }
+
+    void build(const std::vector<T>& values, unsigned fixed_width) {
+        if (fixed_width > 64) {
+            throw std::invalid_argument("Bit width above 64 in Packed_Array");
+        }
+        length = values.size();
+        size_t block_count = (length + block_size - 1) / block_size;
+        std::vector<std::uint64_t> codes(length);
+        blocks.resize(block_count);
+
+        std::uint64_t total_bits = 0;
+        for (size_t b = 0; b < block_count; ++b) {
+            size_t first = b * block_size;
+            size_t count = std::min(block_size, length - first);
+            Block& block = blocks[b];
+            block.reference = encode_block(values.data() + first, count, codes.data() + first);
+            unsigned width = 0;
+            for (size_t i = first; i < first + count; ++i) {
+                width = std::max(width, bits_needed(codes[i]));
+            }
+            if (fixed_width != 0) {
+                if (width > fixed_width) {
+                    throw std::invalid_argument("Value does not fit the chosen bit width in Packed_Array");
+                }
+                width = fixed_width;
+            }
+            block.width = width;
+            block.bit_offset = total_bits;
+            total_bits += static_cast<std::uint64_t>(width) * count;
+        }
+
+        // One spare word lets unpacking read word + 1 without a bounds check
+        words.assign(static_cast<size_t>(total_bits / 64) + 2, 0);
+        for (size_t b = 0; b < block_count; ++b) {
+            size_t first = b * block_size;
+            size_t count = std::min(block_size, length - first);
+            for (size_t i = 0; i < count; ++i) {
+                put(blocks[b].bit_offset + static_cast<std::uint64_t>(blocks[b].width) * i, codes[first + i], blocks[b].width);
+            }
+        }
+    }
+
+    static T from_raw(std::uint64_t value) noexcept {
+        return static_cast<T>(value);
+    }
+
+#if DS_PACKED_AVX2
+    static bool has_avx2() {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+    // Unpacks count codes, four lanes at a time: gather the two words each
+    // field may straddle, shift them into place and mask. AVX2 variable
+    // shifts by 64 yield zero, so fields that sit in one word need no branch.
+    __attribute__((target("avx2")))
+    void unpack_avx2(const Block& block, size_t count, std::uint64_t* codes) const {
+        const long long* base = reinterpret_cast<const long long*>(words.data());
+        const __m256i width = _mm256_set1_epi64x(block.width);
+        const __m256i field_mask = _mm256_set1_epi64x(static_cast<long long>(mask(block.width)));
+        const __m256i sixty_four = _mm256_set1_epi64x(64);
+        const __m256i low_six = _mm256_set1_epi64x(63);
+        __m256i lane = _mm256_set_epi64x(3, 2, 1, 0);
+        const __m256i step = _mm256_set1_epi64x(4);
+        const __m256i start = _mm256_set1_epi64x(static_cast<long long>(block.bit_offset));
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256i bit = _mm256_add_epi64(start, _mm256_mul_epu32(lane, width));
+            __m256i word = _mm256_srli_epi64(bit, 6);
+            __m256i shift = _mm256_and_si256(bit, low_six);
+            __m256i low = _mm256_i64gather_epi64(base, word, 8);
+            __m256i high = _mm256_i64gather_epi64(base, _mm256_add_epi64(word, _mm256_set1_epi64x(1)), 8);
+            __m256i value = _mm256_or_si256(_mm256_srlv_epi64(low, shift),
+                                            _mm256_sllv_epi64(high, _mm256_sub_epi64(sixty_four, shift)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(codes + i), _mm256_and_si256(value, field_mask));
+            lane = _mm256_add_epi64(lane, step);
+        }
+        for (; i < count; ++i) {
+            codes[i] = get(block.bit_offset + static_cast<std::uint64_t>(block.width) * i, block.width);
+        }
+    }
+#endif
+
+public:
+    // Type definitions for STL compatibility
+    using value_type = T;
+    using size_type = size_t;
+
+    /**
+     * @brief Compress a range of values
+     * @param first Iterator to the first value
+     * @param last Iterator past the last value
+     * @param encoding How each block is encoded before packing
+     * @param width Bits per value, or 0 to pick the smallest width per block
+     * @throw std::invalid_argument if a value does not fit a fixed width
+     */
+    template <class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+    Packed_Array(InputIt first, InputIt last, Pack_Encoding encoding = Pack_Encoding::frame_of_reference,
+                 unsigned width = 0)
+        : length(0), encoding(encoding) {
+        std::vector<T> values;
+        for (; first != last; ++first) {
+            values.push_back(*first);
+        }
+        build(values, width);
+    }
+
+    /**
+     * @brief Compress the contents of an Array
+     * @param array The array to compress
+     * @param encoding How each block is encoded before packing
+     * @param width Bits per value, or 0 to pick the smallest width per block
+     */
+    explicit Packed_Array(Array<T>& array, Pack_Encoding encoding = Pack_Encoding::frame_of_reference,
+                          unsigned width = 0)
+        : Packed_Array(array.data(), array.data() + array.get_length(), encoding, width) {}
+
+    /**
+     * @brief Get the number of stored values
+     * @return The number of values in the array
+     */
+    [[nodiscard]] size_t size() const noexcept {
+        return length;
+    }
+
+    /**
+     * @brief Check if the array is empty
+     * @return true if the array is empty, false otherwise
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return length == 0;
+    }
+
+    [[nodiscard]] Pack_Encoding get_encoding() const noexcept {
+        return encoding;
+    }
+
+    /**
+     * @brief Get the number of blocks decode_block() can unpack
+     */
+    [[nodiscard]] size_t block_count() const noexcept {
+        return blocks.size();
+    }
+
+    /**
+     * @brief Get the bit width a block was packed at
+     * @param block The block index
+     */
+    [[nodiscard]] unsigned block_width(size_t block) const {
+        return blocks.at(block).width;
+    }
+
+    /**
+     * @brief Get the bytes used by the packed words and block headers
+     */
+    [[nodiscard]] size_t compressed_bytes() const noexcept {
+        return words.size() * sizeof(std::uint64_t) + blocks.size() * sizeof(Block);
+    }
+
+    /**
+     * @brief Get the uncompressed size divided by the compressed size
+     * @return The compression ratio, e.g. 4.0 when the data takes a quarter of the space
+     */
+    [[nodiscard]] double compression_ratio() const noexcept {
+        return static_cast<double>(length * sizeof(T)) / static_cast<double>(compressed_bytes());
+    }
+
+    /**
+     * @brief Access a value by index
+     * @param pos The position of the value
+     * @return The decoded value
+     * @throw std::out_of_range if pos is out of range
+     */
+    [[nodiscard]] T at(size_t pos) const {
+        if (pos >= length) {
+            throw std::out_of_range("Index out of range in at()");
+        }
+        const Block& block = blocks[pos / block_size];
+        size_t index = pos % block_size;
+        switch (encoding) {
+            case Pack_Encoding::plain: {
+                std::uint64_t code = get(block.bit_offset + static_cast<std::uint64_t>(block.width) * index, block.width);
+                return from_raw(std::is_signed<T>::value ? unzigzag(code) : code);
+            }
+            case Pack_Encoding::frame_of_reference:
+                return from_raw(block.reference + get(block.bit_offset + static_cast<std::uint64_t>(block.width) * index, block.width));
+            case Pack_Encoding::delta: {
+                std::uint64_t value = block.reference;
+                for (size_t i = 1; i <= index; ++i) {
+                    value += unzigzag(get(block.bit_offset + static_cast<std::uint64_t>(block.width) * i, block.width));
+                }
+                return from_raw(value);
+            }
+        }
+        return T();
+    }
+
+    /**
+     * @brief Decode one whole block
+     * @param block The block index
+     * @param out Room for at least block_size values
+     * @return The number of values written
+     * @throw std::out_of_range if block is out of range
+     */
+    size_t decode_block(size_t block, T* out) const {
+        if (block >= blocks.size()) {
+            throw std::out_of_range("Block out of range in decode_block()");
+        }
+        const Block& header = blocks[block];
+        size_t count = std::min(block_size, length - block * block_size);
+        std::uint64_t codes[block_size];
+#if DS_PACKED_AVX2
+        if (header.width != 0 && has_avx2()) {
+            unpack_avx2(header, count, codes);
+        } else
+#endif
+        {
+            for (size_t i = 0; i < count; ++i) {
+                codes[i] = get(header.bit_offset + static_cast<std::uint64_t>(header.width) * i, header.width);
+            }
+        }
+        switch (encoding) {
+            case Pack_Encoding::plain:
+                for (size_t i = 0; i < count; ++i) {
+                    out[i] = from_raw(std::is_signed<T>::value ? unzigzag(codes[i]) : codes[i]);
+                }
+                break;
+            case Pack_Encoding::frame_of_reference:
+                for (size_t i = 0; i < count; ++i) {
+                    out[i] = from_raw(header.reference + codes[i]);
+                }
+                break;
+            case Pack_Encoding::delta: {
+                std::uint64_t value = header.reference;
+                out[0] = from_raw(value);
+                for (size_t i = 1; i < count; ++i) {
+                    value += unzigzag(codes[i]);
+                    out[i] = from_raw(value);
+                }
+                break;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Decode every value in order
+     * @param out Room for at least size() values
+     */
+    void decode(T* out) const {
+        for (size_t b = 0; b < blocks.size(); ++b) {
+            decode_block(b, out + b * block_size);
+        }
+    }
+
+    /**
+     * @brief Print the array contents to standard output
+     */
+    void print() const {
+        T values[block_size];
+        std::cout << "[ ";
+        for (size_t b = 0; b < blocks.size(); ++b) {
+            size_t count = decode_block(b, values);
+            for (size_t i = 0; i < count; ++i) {
+                std::cout << +values[i] << ' ';
+            }
+        }
+        std::cout << ']' << std::endl;
+    }
+};
+
+#endif // PACKED_ARRAY_H
@@ -0,0 +1,242 @@
+/**
+ * @file Parallel.h
+ * @brief Parallel for_each, transform, reduce and merge sort over contiguous storage
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * Each algorithm has an overload that takes a Thread_Pool and one that runs on
+ * Thread_Pool::shared(). The grain is the largest range a single task handles;
+ * 0 picks one that gives every worker several tasks.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Linked_List_Array.h"
+#include "Thread_Pool.h"
+
+namespace parallel_detail {
+
+constexpr size_t min_grain = 2048;
+
+inline size_t pick_grain(size_t n, size_t grain, const Thread_Pool& pool) {
+    if (grain != 0) return grain;
+    return std::max(min_grain, n / (pool.size() * 8) + 1);
+}
+
+// Splits [begin, end) in halves until a piece fits the grain, forking the
+// left half and recursing into the right half on the current thread.
+template <class Body>
+void split(Thread_Pool& pool, Task_Group& group, size_t begin, size_t end, size_t grain, const Body& body) {
+    while (end - begin > grain) {
+        size_t middle = begin + (end - begin) / 2;
+        group.run([&pool, &group, begin, middle, grain, &body] { split(pool, group, begin, middle, grain, body); });
+        begin = middle;
+    }
+    body(begin, end);
+}
+
+// Merges the sorted ranges [first1, last1) and [first2, last2) into out.
+// Large merges split the longer range at its middle, binary-search the
+// matching point in the shorter one and merge the two halves in parallel.
+template <class T, class Compare>
+void merge(Thread_Pool& pool, Task_Group& group, T* first1, T* last1, T* first2, T* last2, T* out,
+           size_t grain, const Compare& comp) {
+    size_t length1 = static_cast<size_t>(last1 - first1);
+    size_t length2 = static_cast<size_t>(last2 - first2);
+    if (length1 + length2 <= grain) {
+        std::merge(std::make_move_iterator(first1), std::make_move_iterator(last1),
+                   std::make_move_iterator(first2), std::make_move_iterator(last2), out, comp);
+        return;
+    }
+    if (length1 < length2) {
+        std::swap(first1, first2);
+        std::swap(last1, last2);
+        std::swap(length1, length2);
+    }
+    T* middle1 = first1 + length1 / 2;
+    T* middle2 = std::lower_bound(first2, last2, *middle1, comp);
+    T* middle_out = out + (middle1 - first1) + (middle2 - first2);
+    group.run([&pool, &group, first1, middle1, first2, middle2, out, grain, &comp] {
+        merge(pool, group, first1, middle1, first2, middle2, out, grain, comp);
+    });
+    merge(pool, group, middle1, last1, middle2, last2, middle_out, grain, comp);
+}
+
+// Sorts [data, data + n). When to_buffer is set the result ends up in buffer,
+// otherwise in data; the two arrays swap roles at each level of recursion.
+template <class T, class Compare>
+void merge_sort(Thread_Pool& pool, T* data, T* buffer, size_t n, bool to_buffer, size_t grain, const Compare& comp) {
+    if (n <= grain) {
+        std::sort(data, data + n, comp);
+        if (to_buffer) std::move(data, data + n, buffer);
+        return;
+    }
+    size_t half = n / 2;
+    {
+        Task_Group group(pool);
+        group.run([&] { merge_sort(pool, data, buffer, half, !to_buffer, grain, comp); });
+        merge_sort(pool, data + half, buffer + half, n - half, !to_buffer, grain, comp);
+        group.wait();
+    }
+    T* source = to_buffer ? data : buffer;
+    T* target = to_buffer ? buffer : data;
+    Task_Group group(pool);
+    merge(pool, group, source, source + half, source + half, source + n, target, grain, comp);
+    group.wait();
+}
+
+} // namespace parallel_detail
+
+/**
+ * @brief Call body(begin, end) over disjoint pieces of [0, n) in parallel
+ * @param pool The pool to run on
+ * @param n The number of indices
+ * @param body Callable taking (size_t begin, size_t end)
+ * @param grain Largest piece handed to one task, or 0 to choose automatically
+ */
+template <class Body>
+void parallel_for(Thread_Pool& pool, size_t n, const Body& body, size_t grain = 0) {
+    if (n == 0) return;
+    grain = parallel_detail::pick_grain(n, grain, pool);
+    Task_Group group(pool);
+    parallel_detail::split(pool, group, 0, n, grain, body);
+    group.wait();
+}
+
+/**
+ * @brief Apply fn to every element in parallel
+ * @param pool The pool to run on
+ * @param data Pointer to the first element
+ * @param n Number of elements
+ * @param fn Callable taking T&
+ * @param grain Largest piece handed to one task, or 0 to choose automatically
+ */
+template <class T, class Fn>
+void parallel_for_each(Thread_Pool& pool, T* data, size_t n, const Fn& fn, size_t grain = 0) {
+    parallel_for(pool, n, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) fn(data[i]);
+    }, grain);
+}
+
+template <class T, class Fn>
+void parallel_for_each(T* data, size_t n, const Fn& fn, size_t grain = 0) {
+    parallel_for_each(Thread_Pool::shared(), data, n, fn, grain);
+}
+
+template <class T, class Fn>
+void parallel_for_each(Array<T>& array, const Fn& fn, size_t grain = 0) {
+    parallel_for_each(Thread_Pool::shared(), array.data(), array.get_length(), fn, grain);
+}
+
+/**
+ * @brief Write fn(in[i]) to out[i] for every element in parallel
+ * @param pool The pool to run on
+ * @param in Pointer to the first input element
+ * @param n Number of elements
+ * @param out Pointer to room for n results; may equal in
+ * @param fn Callable taking const T& and returning the output value
+ * @param grain Largest piece handed to one task, or 0 to choose automatically
+ */
+template <class T, class U, class Fn>
+void parallel_transform(Thread_Pool& pool, const T* in, size_t n, U* out, const Fn& fn, size_t grain = 0) {
+    parallel_for(pool, n, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) out[i] = fn(in[i]);
+    }, grain);
+}
+
+template <class T, class U, class Fn>
+void parallel_transform(const T* in, size_t n, U* out, const Fn& fn, size_t grain = 0) {
+    parallel_transform(Thread_Pool::shared(), in, n, out, fn, grain);
+}
+
+/**
+ * @brief Transform an Array in place
+ */
+template <class T, class Fn>
+void parallel_transform(Array<T>& array, const Fn& fn, size_t grain = 0) {
+    parallel_transform(Thread_Pool::shared(), array.data(), array.get_length(), array.data(), fn, grain);
+}
+
+/**
+ * @brief Combine every element with op in parallel
+ * @param pool The pool to run on
+ * @param data Pointer to the first element
+ * @param n Number of elements
+ * @param init The identity of op; each piece starts from it
+ * @param op An associative binary operation
+ * @param grain Largest piece handed to one task, or 0 to choose automatically
+ * @return The combined value
+ */
+template <class T, class R, class Op>
+R parallel_reduce(Thread_Pool& pool, const T* data, size_t n, R init, const Op& op, size_t grain = 0) {
+    if (n == 0) return init;
+    grain = parallel_detail::pick_grain(n, grain, pool);
+    size_t pieces = (n + grain - 1) / grain;
+    // Not std::vector: a vector<bool> would pack neighbouring pieces into one word
+    std::unique_ptr<R[]> partial(new R[pieces]);
+    parallel_for(pool, pieces, [&](size_t begin, size_t end) {
+        for (size_t piece = begin; piece < end; ++piece) {
+            R value = init;
+            size_t last = std::min(n, (piece + 1) * grain);
+            for (size_t i = piece * grain; i < last; ++i) value = op(value, data[i]);
+            partial[piece] = value;
+        }
+    }, 1);
+    R result = init;
+    for (size_t piece = 0; piece < pieces; ++piece) result = op(result, partial[piece]);
+    return result;
+}
+
+template <class T, class R, class Op>
+R parallel_reduce(const T* data, size_t n, R init, const Op& op, size_t grain = 0) {
+    return parallel_reduce(Thread_Pool::shared(), data, n, init, op, grain);
+}
+
+template <class T, class R, class Op>
+R parallel_reduce(Array<T>& array, R init, const Op& op, size_t grain = 0) {
+    return parallel_reduce(Thread_Pool::shared(), array.data(), array.get_length(), init, op, grain);
+}
+
+/**
+ * @brief Sort with a parallel merge sort
+ *
+ * Pieces up to the grain are sorted with std::sort, then merged in parallel
+ * through one temporary buffer of n elements. The sort is not stable.
+ *
+ * @param pool The pool to run on
+ * @param data Pointer to the first element
+ * @param n Number of elements
+ * @param comp Strict weak ordering
+ * @param grain Largest piece sorted or merged by one task, or 0 to choose automatically
+ */
+template <class T, class Compare = std::less<T>>
+void parallel_sort(Thread_Pool& pool, T* data, size_t n, Compare comp = Compare(), size_t grain = 0) {
+    grain = std::max<size_t>(parallel_detail::pick_grain(n, grain, pool), 2);
+    if (n <= grain) {
+        std::sort(data, data + n, comp);
+        return;
+    }
+    std::vector<T> buffer(n);
+    parallel_detail::merge_sort(pool, data, buffer.data(), n, false, grain, comp);
+}
+
+template <class T, class Compare = std::less<T>>
+void parallel_sort(T* data, size_t n, Compare comp = Compare(), size_t grain = 0) {
+    parallel_sort(Thread_Pool::shared(), data, n, comp, grain);
+}
+
+template <class T, class Compare = std::less<T>>
+void parallel_sort(Array<T>& array, Compare comp = Compare(), size_t grain = 0) {
+    parallel_sort(Thread_Pool::shared(), array.data(), array.get_length(), comp, grain);
+}
+
+#endif // PARALLEL_H
@@ -0,0 +1,267 @@
+/**
+ * @file Perf_Counters.h
+ * @brief Hardware performance counters around a region of code, through Linux perf_event_open
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * Perf_Counters opens one counter per event for the calling thread, user
+ * space only. Each event is opened on its own rather than as a group, so a
+ * machine that lacks one of them (or a container or VM that exposes no PMU
+ * at all) still gets the rest. Counts are scaled by the fraction of the time
+ * the kernel actually had the event scheduled, since six events can be more
+ * than the PMU runs at once; an event the kernel never scheduled has nothing
+ * to scale, so it reads as unavailable rather than as zero. Elsewhere, or
+ * when perf_event_paranoid forbids it, every event reads as unavailable.
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief The events Perf_Counters reads
+ */
+enum class Perf_Event {
+    cycles,
+    instructions,
+    l1d_misses,
+    llc_misses,
+    branch_misses,
+    dtlb_misses
+};
+
+constexpr size_t perf_event_count = 6;
+
+/**
+ * @brief Get a short name for an event, such as "cycles" or "l1d_misses"
+ */
+inline const char* perf_event_name(Perf_Event event) noexcept {
+    switch (event) {
+        case Perf_Event::cycles: return "cycles";
+        case Perf_Event::instructions: return "instructions";
+        case Perf_Event::l1d_misses: return "l1d_misses";
+        case Perf_Event::llc_misses: return "llc_misses";
+        case Perf_Event::branch_misses: return "branch_misses";
+        case Perf_Event::dtlb_misses: return "dtlb_misses";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Counts of every event, NaN where an event is unavailable or never ran
+ */
+struct Perf_Sample {
+    double counts[perf_event_count];
+
+    Perf_Sample() noexcept {
+        for (double& count : counts) count = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    double operator[](Perf_Event event) const noexcept {
+        return counts[static_cast<size_t>(event)];
+    }
+
+    [[nodiscard]] bool has(Perf_Event event) const noexcept {
+        return !std::isnan((*this)[event]);
+    }
+
+    /**
+     * @brief Get the counts divided by a number of operations
+     */
+    [[nodiscard]] Perf_Sample per(double operations) const noexcept {
+        Perf_Sample result;
+        for (size_t i = 0; i < perf_event_count; ++i) result.counts[i] = counts[i] / operations;
+        return result;
+    }
+};
+
+/**
+ * @brief A set of counters for the calling thread that accumulate between start() and stop()
+ */
+class Perf_Counters {
+private:
+    int fds[perf_event_count];
+    double totals[perf_event_count];
+    // Whether any interval since the last reset() had the event scheduled
+    bool counted[perf_event_count];
+#if defined(__linux__)
+    uint64_t enabled_at[perf_event_count];
+    uint64_t running_at[perf_event_count];
+    uint64_t value_at[perf_event_count];
+
+    struct Reading {
+        uint64_t value;
+        uint64_t time_enabled;
+        uint64_t time_running;
+    };
+
+    static void describe(Perf_Event event, perf_event_attr& attr) {
+        auto cache = [](uint64_t cache_id, uint64_t op, uint64_t result) {
+            return cache_id | (op << 8) | (result << 16);
+        };
+        attr.type = PERF_TYPE_HARDWARE;
+        switch (event) {
+            case Perf_Event::cycles:
+                attr.config = PERF_COUNT_HW_CPU_CYCLES;
+                break;
+            case Perf_Event::instructions:
+                attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+                break;
+            case Perf_Event::l1d_misses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = cache(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ,
+                                    PERF_COUNT_HW_CACHE_RESULT_MISS);
+                break;
+            case Perf_Event::llc_misses:
+                attr.config = PERF_COUNT_HW_CACHE_MISSES;
+                break;
+            case Perf_Event::branch_misses:
+                attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+                break;
+            case Perf_Event::dtlb_misses:
+                attr.type = PERF_TYPE_HW_CACHE;
+                attr.config = cache(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                                    PERF_COUNT_HW_CACHE_RESULT_MISS);
+                break;
+        }
+    }
+
+    bool read_counter(size_t i, Reading& reading) const {
+        return ::read(fds[i], &reading, sizeof(reading)) == static_cast<ssize_t>(sizeof(reading));
+    }
+#endif
+
+public:
+    /**
+     * @brief Open every event that is available; never throws for missing ones
+     */
+    Perf_Counters() {
+        for (size_t i = 0; i < perf_event_count; ++i) {
+            fds[i] = -1;
+            totals[i] = 0;
+            counted[i] = false;
+        }
+#if defined(__linux__)
+        for (size_t i = 0; i < perf_event_count; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            describe(static_cast<Perf_Event>(i), attr);
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds[i] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+            enabled_at[i] = running_at[i] = value_at[i] = 0;
+        }
+#endif
+    }
+
+    Perf_Counters(const Perf_Counters&) = delete;
+    Perf_Counters& operator=(const Perf_Counters&) = delete;
+
+    ~Perf_Counters() {
+#if defined(__linux__)
+        for (int fd : fds) {
+            if (fd >= 0) ::close(fd);
+        }
+#endif
+    }
+
+    /**
+     * @brief Check whether an event could be opened
+     */
+    [[nodiscard]] bool available(Perf_Event event) const noexcept {
+        return fds[static_cast<size_t>(event)] >= 0;
+    }
+
+    /**
+     * @brief Check whether any event could be opened
+     */
+    [[nodiscard]] bool any_available() const noexcept {
+        for (int fd : fds) {
+            if (fd >= 0) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Zero the accumulated counts; every event reads as NaN until it is counted again
+     */
+    void reset() noexcept {
+        for (size_t i = 0; i < perf_event_count; ++i) {
+            totals[i] = 0;
+            counted[i] = false;
+        }
+    }
+
+    /**
+     * @brief Start counting
+     */
+    void start() noexcept {
+#if defined(__linux__)
+        for (size_t i = 0; i < perf_event_count; ++i) {
+            Reading reading;
+            if (fds[i] < 0 || !read_counter(i, reading)) continue;
+            value_at[i] = reading.value;
+            enabled_at[i] = reading.time_enabled;
+            running_at[i] = reading.time_running;
+        }
+        for (int fd : fds) {
+            if (fd >= 0) ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    /**
+     * @brief Stop counting and add what was counted since start() to the totals
+     *
+     * An event the kernel did not schedule at all during the interval adds nothing.
+     */
+    void stop() noexcept {
+#if defined(__linux__)
+        for (int fd : fds) {
+            if (fd >= 0) ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+        for (size_t i = 0; i < perf_event_count; ++i) {
+            Reading reading;
+            if (fds[i] < 0 || !read_counter(i, reading)) continue;
+            double value = static_cast<double>(reading.value - value_at[i]);
+            double enabled = static_cast<double>(reading.time_enabled - enabled_at[i]);
+            double running = static_cast<double>(reading.time_running - running_at[i]);
+            // Never scheduled (the PMU was busy the whole time): zero would be a guess
+            if (running <= 0) continue;
+            // Multiplexed events ran for part of the time; extrapolate to the whole interval
+            if (running < enabled) value *= enabled / running;
+            totals[i] += value;
+            counted[i] = true;
+        }
+#endif
+    }
+
+    /**
+     * @brief Get the accumulated counts; unavailable events and events that never ran are NaN
+     */
+    [[nodiscard]] Perf_Sample sample() const noexcept {
+        Perf_Sample result;
+        for (size_t i = 0; i < perf_event_count; ++i) {
+            if (fds[i] >= 0 && counted[i]) result.counts[i] = totals[i];
+        }
+        return result;
+    }
+};
+
+#endif // PERF_COUNTERS_H
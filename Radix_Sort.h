@@ -0,0 +1,258 @@
+/**
+ * @file Radix_Sort.h
+ * @brief Stable LSD radix sort for integer and floating-point keys
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * Keys are mapped to unsigned integers with the same order: signed keys get
+ * their sign bit flipped, and floating-point keys get the sign bit flipped
+ * when positive and every bit flipped when negative (so -0.0 sorts just
+ * before +0.0 and NaNs land at the end matching their sign). The digit
+ * histograms of all passes are counted in one read of the keys, and a pass
+ * is skipped when every key has the same digit there.
+ */
+
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Declared rather than included so the linked lists can use this header
+// without pulling in Linked_List_Array.h
+template <class t>
+class Array;
+
+namespace radix_detail {
+
+// Below this many elements the histograms cost more than a comparison sort
+constexpr size_t small_sort_size = 256;
+
+// Moves data[order[i]] to data[i] for every i by following each cycle of the
+// permutation once; order is left as the identity
+template <class T, class Index>
+void apply_order(T* data, Index* order, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (order[i] == i) continue;
+        T held = std::move(data[i]);
+        size_t j = i;
+        while (order[j] != i) {
+            size_t next = order[j];
+            data[j] = std::move(data[next]);
+            order[j] = static_cast<Index>(j);
+            j = next;
+        }
+        data[j] = std::move(held);
+        order[j] = static_cast<Index>(j);
+    }
+}
+
+template <class K>
+using Bits = typename std::conditional<(sizeof(K) <= 4), uint32_t, uint64_t>::type;
+
+template <class K>
+constexpr unsigned key_bits = sizeof(K) * 8;
+
+template <class K>
+void check_key() {
+    static_assert(std::is_arithmetic<K>::value && !std::is_same<K, bool>::value,
+                  "radix_sort keys must be integer or floating-point values");
+    static_assert(sizeof(K) <= 8, "radix_sort keys must be at most 64 bits wide");
+}
+
+// Maps a key to an unsigned value with the same ordering
+template <class K>
+Bits<K> to_bits(K key) noexcept {
+    using B = Bits<K>;
+    constexpr B sign = B(1) << (key_bits<K> - 1);
+    if constexpr (std::is_floating_point<K>::value) {
+        B bits;
+        std::memcpy(&bits, &key, sizeof(K));
+        return (bits & sign) ? ~bits : (bits | sign);
+    } else if constexpr (std::is_signed<K>::value) {
+        return static_cast<B>(static_cast<typename std::make_unsigned<K>::type>(key)) ^ sign;
+    } else {
+        return static_cast<B>(key);
+    }
+}
+
+template <class K>
+K from_bits(Bits<K> bits) noexcept {
+    using B = Bits<K>;
+    constexpr B sign = B(1) << (key_bits<K> - 1);
+    if constexpr (std::is_floating_point<K>::value) {
+        bits = (bits & sign) ? (bits ^ sign) : ~bits;
+        K key;
+        std::memcpy(&key, &bits, sizeof(K));
+        return key;
+    } else if constexpr (std::is_signed<K>::value) {
+        return static_cast<K>(static_cast<typename std::make_unsigned<K>::type>(bits ^ sign));
+    } else {
+        return static_cast<K>(bits);
+    }
+}
+
+struct No_Items {};
+
+// Sorts keys (and items alongside, when given) using buffers of the same size.
+// The result always ends up back in keys and items.
+template <unsigned DigitBits, unsigned Width, class B, class Item>
+void sort_bits(B* keys, B* key_buffer, Item* items, Item* item_buffer, size_t n) {
+    static_assert(DigitBits >= 1 && DigitBits <= 16, "radix_sort digits must be 1 to 16 bits wide");
+    constexpr bool has_items = !std::is_same<Item, No_Items>::value;
+    constexpr unsigned passes = (Width + DigitBits - 1) / DigitBits;
+    constexpr size_t buckets = size_t(1) << DigitBits;
+    constexpr B mask = static_cast<B>(buckets - 1);
+
+    std::vector<size_t> counts(passes * buckets, 0);
+    for (size_t i = 0; i < n; ++i) {
+        B key = keys[i];
+        for (unsigned pass = 0; pass < passes; ++pass) {
+            ++counts[pass * buckets + ((key >> (pass * DigitBits)) & mask)];
+        }
+    }
+
+    bool in_buffer = false;
+    for (unsigned pass = 0; pass < passes; ++pass) {
+        size_t* count = counts.data() + pass * buckets;
+        unsigned shift = pass * DigitBits;
+        B* from_keys = in_buffer ? key_buffer : keys;
+        if (count[(from_keys[0] >> shift) & mask] == n) {
+            continue;
+        }
+        size_t offset = 0;
+        for (size_t digit = 0; digit < buckets; ++digit) {
+            size_t next = offset + count[digit];
+            count[digit] = offset;
+            offset = next;
+        }
+        B* to_keys = in_buffer ? keys : key_buffer;
+        if constexpr (has_items) {
+            Item* from_items = in_buffer ? item_buffer : items;
+            Item* to_items = in_buffer ? items : item_buffer;
+            for (size_t i = 0; i < n; ++i) {
+                size_t slot = count[(from_keys[i] >> shift) & mask]++;
+                to_keys[slot] = from_keys[i];
+                to_items[slot] = std::move(from_items[i]);
+            }
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                to_keys[count[(from_keys[i] >> shift) & mask]++] = from_keys[i];
+            }
+        }
+        in_buffer = !in_buffer;
+    }
+
+    if (in_buffer) {
+        std::copy(key_buffer, key_buffer + n, keys);
+        if constexpr (has_items) {
+            std::move(item_buffer, item_buffer + n, items);
+        }
+    }
+}
+
+// With DigitBits == 0, 8-bit digits are used for short keys and for inputs
+// small enough that 2048-entry histograms would not pay off; otherwise 11-bit
+// digits cut 32-bit keys to three passes and 64-bit keys to six.
+template <unsigned DigitBits, class K, class B, class Item>
+void sort_keys(B* keys, B* key_buffer, Item* items, Item* item_buffer, size_t n) {
+    if constexpr (DigitBits != 0) {
+        sort_bits<DigitBits, key_bits<K>>(keys, key_buffer, items, item_buffer, n);
+    } else if constexpr (key_bits<K> <= 16) {
+        sort_bits<8, key_bits<K>>(keys, key_buffer, items, item_buffer, n);
+    } else {
+        if (n < (size_t(1) << 16)) {
+            sort_bits<8, key_bits<K>>(keys, key_buffer, items, item_buffer, n);
+        } else {
+            sort_bits<11, key_bits<K>>(keys, key_buffer, items, item_buffer, n);
+        }
+    }
+}
+
+} // namespace radix_detail
+
+/**
+ * @brief Sort integer or floating-point values in ascending order
+ * @tparam DigitBits Bits per pass (for example 8 or 11); 0 picks from the key width and n
+ * @param data Pointer to the first element
+ * @param n Number of elements
+ */
+template <unsigned DigitBits = 0, class T>
+void radix_sort(T* data, size_t n) {
+    radix_detail::check_key<T>();
+    using B = radix_detail::Bits<T>;
+    if (n < radix_detail::small_sort_size) {
+        std::sort(data, data + n, [](T a, T b) { return radix_detail::to_bits(a) < radix_detail::to_bits(b); });
+        return;
+    }
+    std::vector<B> keys(2 * n);
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = radix_detail::to_bits(data[i]);
+    }
+    radix_detail::No_Items* none = nullptr;
+    radix_detail::sort_keys<DigitBits, T>(keys.data(), keys.data() + n, none, none, n);
+    for (size_t i = 0; i < n; ++i) {
+        data[i] = radix_detail::from_bits<T>(keys[i]);
+    }
+}
+
+/**
+ * @brief Stable sort of any elements by an integer or floating-point key
+ *
+ * Each key is extracted once. Elements are moved into a buffer and back, so
+ * for large records it can pay off to sort pointers or indices instead.
+ *
+ * @tparam DigitBits Bits per pass (for example 8 or 11); 0 picks from the key width and n
+ * @param data Pointer to the first element
+ * @param n Number of elements
+ * @param key Callable taking const T& and returning the key
+ */
+template <unsigned DigitBits = 0, class T, class Key>
+void radix_sort(T* data, size_t n, Key key) {
+    using K = typename std::decay<decltype(key(*data))>::type;
+    radix_detail::check_key<K>();
+    using B = radix_detail::Bits<K>;
+    if (n < radix_detail::small_sort_size) {
+        // Sort byte indices by keys extracted up front, then apply the order in place
+        B small_keys[radix_detail::small_sort_size];
+        unsigned char order[radix_detail::small_sort_size];
+        for (size_t i = 0; i < n; ++i) {
+            small_keys[i] = radix_detail::to_bits<K>(key(data[i]));
+            order[i] = static_cast<unsigned char>(i);
+        }
+        std::stable_sort(order, order + n, [&small_keys](unsigned char a, unsigned char b) {
+            return small_keys[a] < small_keys[b];
+        });
+        radix_detail::apply_order(data, order, n);
+        return;
+    }
+    std::vector<B> keys(2 * n);
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = radix_detail::to_bits<K>(key(data[i]));
+    }
+    std::vector<T> buffer(n);
+    radix_detail::sort_keys<DigitBits, K>(keys.data(), keys.data() + n, data, buffer.data(), n);
+}
+
+/**
+ * @brief Sort an Array of integer or floating-point values
+ */
+template <unsigned DigitBits = 0, class T>
+void radix_sort(Array<T>& array) {
+    radix_sort<DigitBits>(array.data(), array.get_length());
+}
+
+/**
+ * @brief Stable sort of an Array by an integer or floating-point key
+ */
+template <unsigned DigitBits = 0, class T, class Key>
+void radix_sort(Array<T>& array, Key key) {
+    radix_sort<DigitBits>(array.data(), array.get_length(), key);
+}
+
+#endif // RADIX_SORT_H
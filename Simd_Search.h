@@ -0,0 +1,613 @@
+/**
+ * @file Simd_Search.h
+ * @brief Vectorized search and reductions over contiguous container storage
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ *
+ * Every function takes a pointer and a length, so it runs over Array storage,
+ * the two halves of a Gap_Buffer, or any other contiguous chunk. Kernels exist
+ * for std::int32_t and double with SSE2 and AVX2; AVX2 is picked at runtime
+ * when the CPU supports it. Other arithmetic types, and targets other than
+ * x86-64 with GCC or Clang, use the scalar loops.
+ */
+
+#ifndef SIMD_SEARCH_H
+#define SIMD_SEARCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Linked_List_Array.h"
+#include "Gap_Buffer.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DS_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define DS_SIMD_X86 0
+#endif
+
+/**
+ * @brief Accumulator type used by simd_sum()
+ * @tparam T The element type
+ */
+template <class T>
+using Simd_Sum_Type = std::conditional_t<std::is_floating_point<T>::value, double,
+                      std::conditional_t<std::is_signed<T>::value, long long, unsigned long long>>;
+
+namespace simd_detail {
+
+constexpr size_t npos = static_cast<size_t>(-1);
+
+template <class T>
+constexpr bool has_kernel = std::is_same<T, std::int32_t>::value || std::is_same<T, double>::value;
+
+template <class T>
+size_t find_scalar(const T* data, size_t n, T value) {
+    for (size_t i = 0; i < n; ++i) {
+        if (data[i] == value) return i;
+    }
+    return npos;
+}
+
+template <class T>
+size_t count_scalar(const T* data, size_t n, T value) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        count += data[i] == value;
+    }
+    return count;
+}
+
+template <class T>
+T min_scalar(const T* data, size_t n) {
+    T result = data[0];
+    for (size_t i = 1; i < n; ++i) {
+        if (data[i] < result) result = data[i];
+    }
+    return result;
+}
+
+template <class T>
+T max_scalar(const T* data, size_t n) {
+    T result = data[0];
+    for (size_t i = 1; i < n; ++i) {
+        if (result < data[i]) result = data[i];
+    }
+    return result;
+}
+
+template <class T>
+Simd_Sum_Type<T> sum_scalar(const T* data, size_t n) {
+    Simd_Sum_Type<T> sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+template <class T>
+bool contains_any_scalar(const T* data, size_t n, const T* needles, size_t m) {
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            if (data[i] == needles[j]) return true;
+        }
+    }
+    return false;
+}
+
+#if DS_SIMD_X86
+
+#define DS_AVX2 __attribute__((target("avx2")))
+
+inline bool has_avx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+// ---- std::int32_t, SSE2 ----
+
+inline size_t find_sse2(const std::int32_t* data, size_t n, std::int32_t value) {
+    const __m128i needle = _mm_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, needle)));
+        if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+    size_t rest = find_scalar(data + i, n - i, value);
+    return rest == npos ? npos : i + rest;
+}
+
+inline size_t count_sse2(const std::int32_t* data, size_t n, std::int32_t value) {
+    const __m128i needle = _mm_set1_epi32(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        count += static_cast<size_t>(__builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, needle)))));
+    }
+    return count + count_scalar(data + i, n - i, value);
+}
+
+// SSE2 has no 32-bit min/max, so both select through a compare mask.
+inline std::int32_t min_sse2(const std::int32_t* data, size_t n) {
+    if (n < 4) return min_scalar(data, n);
+    __m128i best = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i less = _mm_cmplt_epi32(x, best);
+        best = _mm_or_si128(_mm_and_si128(less, x), _mm_andnot_si128(less, best));
+    }
+    alignas(16) std::int32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), best);
+    std::int32_t result = min_scalar(lanes, 4);
+    for (; i < n; ++i) {
+        if (data[i] < result) result = data[i];
+    }
+    return result;
+}
+
+inline std::int32_t max_sse2(const std::int32_t* data, size_t n) {
+    if (n < 4) return max_scalar(data, n);
+    __m128i best = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i greater = _mm_cmpgt_epi32(x, best);
+        best = _mm_or_si128(_mm_and_si128(greater, x), _mm_andnot_si128(greater, best));
+    }
+    alignas(16) std::int32_t lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), best);
+    std::int32_t result = max_scalar(lanes, 4);
+    for (; i < n; ++i) {
+        if (result < data[i]) result = data[i];
+    }
+    return result;
+}
+
+// Lanes are sign-extended to 64 bits before adding so the sum cannot wrap.
+inline long long sum_sse2(const std::int32_t* data, size_t n) {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i sign = _mm_srai_epi32(x, 31);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(x, sign));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(x, sign));
+    }
+    alignas(16) long long lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1] + sum_scalar(data + i, n - i);
+}
+
+inline bool contains_any_sse2(const std::int32_t* data, size_t n, const std::int32_t* needles, size_t m) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hit = _mm_setzero_si128();
+        for (size_t j = 0; j < m; ++j) {
+            hit = _mm_or_si128(hit, _mm_cmpeq_epi32(x, _mm_set1_epi32(needles[j])));
+        }
+        if (_mm_movemask_epi8(hit) != 0) return true;
+    }
+    return contains_any_scalar(data + i, n - i, needles, m);
+}
+
+// ---- std::int32_t, AVX2 ----
+
+DS_AVX2 inline size_t find_avx2(const std::int32_t* data, size_t n, std::int32_t value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, needle)));
+        if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+    size_t rest = find_scalar(data + i, n - i, value);
+    return rest == npos ? npos : i + rest;
+}
+
+DS_AVX2 inline size_t count_avx2(const std::int32_t* data, size_t n, std::int32_t value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        count += static_cast<size_t>(__builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, needle)))));
+    }
+    return count + count_scalar(data + i, n - i, value);
+}
+
+DS_AVX2 inline std::int32_t min_avx2(const std::int32_t* data, size_t n) {
+    if (n < 8) return min_scalar(data, n);
+    __m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    __m256i best1 = best, best2 = best, best3 = best;
+    size_t i = 8;
+    // Four independent accumulators keep the min chain off the critical path
+    for (; i + 32 <= n; i += 32) {
+        best = _mm256_min_epi32(best, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+        best1 = _mm256_min_epi32(best1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 8)));
+        best2 = _mm256_min_epi32(best2, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 16)));
+        best3 = _mm256_min_epi32(best3, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 24)));
+    }
+    best = _mm256_min_epi32(_mm256_min_epi32(best, best1), _mm256_min_epi32(best2, best3));
+    for (; i + 8 <= n; i += 8) {
+        best = _mm256_min_epi32(best, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+    }
+    alignas(32) std::int32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), best);
+    std::int32_t result = min_scalar(lanes, 8);
+    for (; i < n; ++i) {
+        if (data[i] < result) result = data[i];
+    }
+    return result;
+}
+
+DS_AVX2 inline std::int32_t max_avx2(const std::int32_t* data, size_t n) {
+    if (n < 8) return max_scalar(data, n);
+    __m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+    __m256i best1 = best, best2 = best, best3 = best;
+    size_t i = 8;
+    // Four independent accumulators keep the max chain off the critical path
+    for (; i + 32 <= n; i += 32) {
+        best = _mm256_max_epi32(best, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+        best1 = _mm256_max_epi32(best1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 8)));
+        best2 = _mm256_max_epi32(best2, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 16)));
+        best3 = _mm256_max_epi32(best3, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 24)));
+    }
+    best = _mm256_max_epi32(_mm256_max_epi32(best, best1), _mm256_max_epi32(best2, best3));
+    for (; i + 8 <= n; i += 8) {
+        best = _mm256_max_epi32(best, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+    }
+    alignas(32) std::int32_t lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), best);
+    std::int32_t result = max_scalar(lanes, 8);
+    for (; i < n; ++i) {
+        if (result < data[i]) result = data[i];
+    }
+    return result;
+}
+
+DS_AVX2 inline long long sum_avx2(const std::int32_t* data, size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(x)));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(x, 1)));
+    }
+    alignas(32) long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_scalar(data + i, n - i);
+}
+
+DS_AVX2 inline bool contains_any_avx2(const std::int32_t* data, size_t n, const std::int32_t* needles, size_t m) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i hit = _mm256_setzero_si256();
+        for (size_t j = 0; j < m; ++j) {
+            hit = _mm256_or_si256(hit, _mm256_cmpeq_epi32(x, _mm256_set1_epi32(needles[j])));
+        }
+        if (!_mm256_testz_si256(hit, hit)) return true;
+    }
+    return contains_any_scalar(data + i, n - i, needles, m);
+}
+
+// ---- double, SSE2 ----
+
+inline size_t find_sse2(const double* data, size_t n, double value) {
+    const __m128d needle = _mm_set1_pd(value);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(data + i), needle));
+        if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+    size_t rest = find_scalar(data + i, n - i, value);
+    return rest == npos ? npos : i + rest;
+}
+
+inline size_t count_sse2(const double* data, size_t n, double value) {
+    const __m128d needle = _mm_set1_pd(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        count += static_cast<size_t>(__builtin_popcount(_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(data + i), needle))));
+    }
+    return count + count_scalar(data + i, n - i, value);
+}
+
+inline double min_sse2(const double* data, size_t n) {
+    if (n < 2) return min_scalar(data, n);
+    __m128d best = _mm_loadu_pd(data);
+    size_t i = 2;
+    for (; i + 2 <= n; i += 2) {
+        best = _mm_min_pd(best, _mm_loadu_pd(data + i));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, best);
+    double result = min_scalar(lanes, 2);
+    for (; i < n; ++i) {
+        if (data[i] < result) result = data[i];
+    }
+    return result;
+}
+
+inline double max_sse2(const double* data, size_t n) {
+    if (n < 2) return max_scalar(data, n);
+    __m128d best = _mm_loadu_pd(data);
+    size_t i = 2;
+    for (; i + 2 <= n; i += 2) {
+        best = _mm_max_pd(best, _mm_loadu_pd(data + i));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, best);
+    double result = max_scalar(lanes, 2);
+    for (; i < n; ++i) {
+        if (result < data[i]) result = data[i];
+    }
+    return result;
+}
+
+inline double sum_sse2(const double* data, size_t n) {
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        acc = _mm_add_pd(acc, _mm_loadu_pd(data + i));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, acc);
+    return lanes[0] + lanes[1] + sum_scalar(data + i, n - i);
+}
+
+// ---- double, AVX2 ----
+
+DS_AVX2 inline size_t find_avx2(const double* data, size_t n, double value) {
+    const __m256d needle = _mm256_set1_pd(value);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(data + i), needle, _CMP_EQ_OQ));
+        if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+    size_t rest = find_scalar(data + i, n - i, value);
+    return rest == npos ? npos : i + rest;
+}
+
+DS_AVX2 inline size_t count_avx2(const double* data, size_t n, double value) {
+    const __m256d needle = _mm256_set1_pd(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        count += static_cast<size_t>(__builtin_popcount(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(data + i), needle, _CMP_EQ_OQ))));
+    }
+    return count + count_scalar(data + i, n - i, value);
+}
+
+DS_AVX2 inline double min_avx2(const double* data, size_t n) {
+    if (n < 4) return min_scalar(data, n);
+    __m256d best = _mm256_loadu_pd(data);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        best = _mm256_min_pd(best, _mm256_loadu_pd(data + i));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, best);
+    double result = min_scalar(lanes, 4);
+    for (; i < n; ++i) {
+        if (data[i] < result) result = data[i];
+    }
+    return result;
+}
+
+DS_AVX2 inline double max_avx2(const double* data, size_t n) {
+    if (n < 4) return max_scalar(data, n);
+    __m256d best = _mm256_loadu_pd(data);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        best = _mm256_max_pd(best, _mm256_loadu_pd(data + i));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, best);
+    double result = max_scalar(lanes, 4);
+    for (; i < n; ++i) {
+        if (result < data[i]) result = data[i];
+    }
+    return result;
+}
+
+DS_AVX2 inline double sum_avx2(const double* data, size_t n) {
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm256_add_pd(acc, _mm256_loadu_pd(data + i));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sum_scalar(data + i, n - i);
+}
+
+#undef DS_AVX2
+
+#endif // DS_SIMD_X86
+
+} // namespace simd_detail
+
+/**
+ * @brief Find the first element equal to value
+ * @param data Pointer to the first element
+ * @param n Number of elements
+ * @param value The value to find
+ * @return The index of the value, or -1 if not found
+ */
+template <class T>
+[[nodiscard]] size_t simd_find(const T* data, size_t n, const T& value) {
+    static_assert(std::is_arithmetic<T>::value, "simd_find() requires an arithmetic type");
+#if DS_SIMD_X86
+    if constexpr (simd_detail::has_kernel<T>) {
+        return simd_detail::has_avx2() ? simd_detail::find_avx2(data, n, value)
+                                       : simd_detail::find_sse2(data, n, value);
+    }
+#endif
+    return simd_detail::find_scalar(data, n, value);
+}
+
+/**
+ * @brief Count the elements equal to value
+ * @param data Pointer to the first element
+ * @param n Number of elements
+ * @param value The value to count
+ * @return The number of matching elements
+ */
+template <class T>
+[[nodiscard]] size_t simd_count(const T* data, size_t n, const T& value) {
+    static_assert(std::is_arithmetic<T>::value, "simd_count() requires an arithmetic type");
+#if DS_SIMD_X86
+    if constexpr (simd_detail::has_kernel<T>) {
+        return simd_detail::has_avx2() ? simd_detail::count_avx2(data, n, value)
+                                       : simd_detail::count_sse2(data, n, value);
+    }
+#endif
+    return simd_detail::count_scalar(data, n, value);
+}
+
+/**
+ * @brief Find the smallest element
+ * @param data Pointer to the first element
+ * @param n Number of elements
+ * @return The smallest element; NaN handling is unspecified
+ * @throw std::runtime_error if the range is empty
+ */
+template <class T>
+[[nodiscard]] T simd_min(const T* data, size_t n) {
+    static_assert(std::is_arithmetic<T>::value, "simd_min() requires an arithmetic type");
+    if (n == 0) {
+        throw std::runtime_error("Range is empty in simd_min()");
+    }
+#if DS_SIMD_X86
+    if constexpr (simd_detail::has_kernel<T>) {
+        return simd_detail::has_avx2() ? simd_detail::min_avx2(data, n) : simd_detail::min_sse2(data, n);
+    }
+#endif
+    return simd_detail::min_scalar(data, n);
+}
+
+/**
+ * @brief Find the largest element
+ * @param data Pointer to the first element
+ * @param n Number of elements
+ * @return The largest element; NaN handling is unspecified
+ * @throw std::runtime_error if the range is empty
+ */
+template <class T>
+[[nodiscard]] T simd_max(const T* data, size_t n) {
+    static_assert(std::is_arithmetic<T>::value, "simd_max() requires an arithmetic type");
+    if (n == 0) {
+        throw std::runtime_error("Range is empty in simd_max()");
+    }
+#if DS_SIMD_X86
+    if constexpr (simd_detail::has_kernel<T>) {
+        return simd_detail::has_avx2() ? simd_detail::max_avx2(data, n) : simd_detail::max_sse2(data, n);
+    }
+#endif
+    return simd_detail::max_scalar(data, n);
+}
+
+/**
+ * @brief Sum the elements in a wide accumulator
+ * @param data Pointer to the first element
+ * @param n Number of elements
+ * @return The sum; floating-point sums are accumulated out of order
+ */
+template <class T>
+[[nodiscard]] Simd_Sum_Type<T> simd_sum(const T* data, size_t n) {
+    static_assert(std::is_arithmetic<T>::value, "simd_sum() requires an arithmetic type");
+#if DS_SIMD_X86
+    if constexpr (simd_detail::has_kernel<T>) {
+        return simd_detail::has_avx2() ? simd_detail::sum_avx2(data, n) : simd_detail::sum_sse2(data, n);
+    }
+#endif
+    return simd_detail::sum_scalar(data, n);
+}
+
+/**
+ * @brief Check whether any element equals one of a small set of needles
+ * @param data Pointer to the first element
+ * @param n Number of elements
+ * @param needles Pointer to the values to look for
+ * @param m Number of needles
+ * @return true if at least one element matches
+ */
+template <class T>
+[[nodiscard]] bool simd_contains_any(const T* data, size_t n, const T* needles, size_t m) {
+    static_assert(std::is_arithmetic<T>::value, "simd_contains_any() requires an arithmetic type");
+#if DS_SIMD_X86
+    if constexpr (std::is_same<T, std::int32_t>::value) {
+        return simd_detail::has_avx2() ? simd_detail::contains_any_avx2(data, n, needles, m)
+                                       : simd_detail::contains_any_sse2(data, n, needles, m);
+    }
+#endif
+    return simd_detail::contains_any_scalar(data, n, needles, m);
+}
+
+// ---- Container overloads ----
+
+template <class T>
+[[nodiscard]] size_t simd_find(Array<T>& array, const T& value) {
+    return simd_find(array.data(), array.get_length(), value);
+}
+
+template <class T>
+[[nodiscard]] size_t simd_count(Array<T>& array, const T& value) {
+    return simd_count(array.data(), array.get_length(), value);
+}
+
+template <class T>
+[[nodiscard]] T simd_min(Array<T>& array) {
+    return simd_min(array.data(), array.get_length());
+}
+
+template <class T>
+[[nodiscard]] T simd_max(Array<T>& array) {
+    return simd_max(array.data(), array.get_length());
+}
+
+template <class T>
+[[nodiscard]] Simd_Sum_Type<T> simd_sum(Array<T>& array) {
+    return simd_sum(array.data(), array.get_length());
+}
+
+template <class T>
+[[nodiscard]] bool simd_contains_any(Array<T>& array, const T* needles, size_t m) {
+    return simd_contains_any(array.data(), array.get_length(), needles, m);
+}
+
+/**
+ * @brief Find the first element equal to value across both halves of a gap buffer
+ * @return The logical index of the value, or -1 if not found
+ */
+template <class T>
+[[nodiscard]] size_t simd_find(const Gap_Buffer<T>& buffer, const T& value) {
+    size_t index = simd_find(buffer.data_before_gap(), buffer.cursor(), value);
+    if (index != simd_detail::npos) return index;
+    index = simd_find(buffer.data_after_gap(), buffer.size() - buffer.cursor(), value);
+    return index == simd_detail::npos ? index : buffer.cursor() + index;
+}
+
+template <class T>
+[[nodiscard]] size_t simd_count(const Gap_Buffer<T>& buffer, const T& value) {
+    return simd_count(buffer.data_before_gap(), buffer.cursor(), value)
+         + simd_count(buffer.data_after_gap(), buffer.size() - buffer.cursor(), value);
+}
+
+template <class T>
+[[nodiscard]] Simd_Sum_Type<T> simd_sum(const Gap_Buffer<T>& buffer) {
+    return simd_sum(buffer.data_before_gap(), buffer.cursor())
+         + simd_sum(buffer.data_after_gap(), buffer.size() - buffer.cursor());
+}
+
+#endif // SIMD_SEARCH_H
@@ -0,0 +1,433 @@
+/**
+ * @file Small_Array.h
+ * @brief A dynamic array that stores its first N elements inline
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ */
+
+#ifndef SMALL_ARRAY_H
+#define SMALL_ARRAY_H
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+/**
+ * @brief A dynamic array with inline capacity for small sizes
+ *
+ * Up to N elements live inside the object itself, so small arrays never touch
+ * the heap. The first push past N moves everything into a heap buffer that
+ * then grows geometrically. The interface mirrors Array, except for errors:
+ * where Array prints a message and carries on (and its at() returns a
+ * default value), Small_Array throws std::out_of_range or std::runtime_error,
+ * since at() returns a reference and has nothing to return instead.
+ *
+ * @tparam T The type of elements stored in the array
+ * @tparam N The number of elements stored inline
+ */
+template <class T, size_t N = 16>
+class Small_Array {
+private:
+    static_assert(N > 0, "Small_Array needs at least one inline slot");
+
+    T* items;
+    size_t length;
+    size_t capacity;
+    alignas(T) unsigned char inline_storage[N * sizeof(T)];
+
+    T* inline_items() noexcept {
+        return reinterpret_cast<T*>(inline_storage);
+    }
+
+    /**
+     * @brief Move count live elements from src into uninitialized dst and destroy the sources
+     */
+    static void relocate(T* dst, T* src, size_t count) {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if (count != 0) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+            }
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                ::new (static_cast<void*>(dst + i)) T(std::move_if_noexcept(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+
+    /**
+     * @brief Make room for at least min_capacity elements
+     */
+    void reserve_for(size_t min_capacity) {
+        if (min_capacity <= capacity) return;
+        size_t new_capacity = std::max(capacity * 2, min_capacity);
+        T* new_items = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
+        relocate(new_items, items, length);
+        adopt_buffer(new_items, new_capacity);
+    }
+
+    /**
+     * @brief Replace the storage with a heap buffer the live elements have been relocated into
+     */
+    void adopt_buffer(T* new_items, size_t new_capacity) noexcept {
+        release_heap();
+        items = new_items;
+        capacity = new_capacity;
+    }
+
+    void release_heap() noexcept {
+        if (is_spilled()) {
+            ::operator delete(items);
+        }
+    }
+
+    void destroy_all() noexcept {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (size_t i = 0; i < length; ++i) {
+                items[i].~T();
+            }
+        }
+        length = 0;
+    }
+
+    /**
+     * @brief Take other's elements, stealing its heap buffer when it has spilled
+     */
+    void steal(Small_Array& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (other.is_spilled()) {
+            items = other.items;
+            capacity = other.capacity;
+            length = other.length;
+            other.items = other.inline_items();
+            other.capacity = N;
+            other.length = 0;
+        } else {
+            for (size_t i = 0; i < other.length; ++i) {
+                ::new (static_cast<void*>(items + i)) T(std::move(other.items[i]));
+            }
+            length = other.length;
+            other.destroy_all();
+        }
+    }
+
+public:
+    // Type definitions for STL compatibility
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+
+    /**
+     * @brief Default constructor; never allocates
+     */
+    Small_Array() noexcept : items(inline_items()), length(0), capacity(N) {}
+
+    /**
+     * @brief Copy constructor
+     * @param other The array to copy from
+     */
+    Small_Array(const Small_Array& other) : Small_Array() {
+        reserve_for(other.length);
+        for (size_t i = 0; i < other.length; ++i) {
+            ::new (static_cast<void*>(items + i)) T(other.items[i]);
+            ++length;
+        }
+    }
+
+    /**
+     * @brief Move constructor
+     * @param other The array to move from
+     */
+    Small_Array(Small_Array&& other) noexcept(std::is_nothrow_move_constructible<T>::value) : Small_Array() {
+        steal(other);
+    }
+
+    /**
+     * @brief Copy assignment operator
+     * @param other The array to copy from
+     * @return Reference to this array
+     */
+    Small_Array& operator=(const Small_Array& other) {
+        if (this != &other) {
+            clear();
+            reserve_for(other.length);
+            for (size_t i = 0; i < other.length; ++i) {
+                ::new (static_cast<void*>(items + i)) T(other.items[i]);
+                ++length;
+            }
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move assignment operator
+     * @param other The array to move from
+     * @return Reference to this array
+     */
+    Small_Array& operator=(Small_Array&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            destroy_all();
+            release_heap();
+            items = inline_items();
+            capacity = N;
+            steal(other);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destructor
+     */
+    ~Small_Array() {
+        destroy_all();
+        release_heap();
+    }
+
+    /**
+     * @brief Check if the array is empty
+     * @return true if the array is empty, false otherwise
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return length == 0;
+    }
+
+    /**
+     * @brief Get the number of stored elements
+     * @return The number of elements in the array
+     */
+    [[nodiscard]] size_t get_length() const noexcept {
+        return length;
+    }
+
+    /**
+     * @brief Get the number of stored elements
+     * @return The number of elements in the array
+     */
+    [[nodiscard]] size_t size() const noexcept {
+        return length;
+    }
+
+    /**
+     * @brief Get the number of elements that fit without reallocating
+     * @return The current capacity
+     */
+    [[nodiscard]] size_t get_capacity() const noexcept {
+        return capacity;
+    }
+
+    /**
+     * @brief Check whether the elements have moved to the heap
+     * @return true once the array has outgrown its inline storage
+     */
+    [[nodiscard]] bool is_spilled() const noexcept {
+        return items != reinterpret_cast<const T*>(inline_storage);
+    }
+
+    T* data() noexcept {
+        return items;
+    }
+
+    const T* data() const noexcept {
+        return items;
+    }
+
+    /**
+     * @brief Add an element to the end of the array
+     * @param value The value to add
+     */
+    void push_back(const T& value) {
+        if (length == capacity) {
+            T copy(value);
+            reserve_for(length + 1);
+            ::new (static_cast<void*>(items + length)) T(std::move(copy));
+        } else {
+            ::new (static_cast<void*>(items + length)) T(value);
+        }
+        ++length;
+    }
+
+    /**
+     * @brief Add an element to the end of the array using move semantics
+     * @param value The value to add
+     */
+    void push_back(T&& value) {
+        if (length == capacity) {
+            T moved(std::move(value));
+            reserve_for(length + 1);
+            ::new (static_cast<void*>(items + length)) T(std::move(moved));
+        } else {
+            ::new (static_cast<void*>(items + length)) T(std::move(value));
+        }
+        ++length;
+    }
+
+    /**
+     * @brief Add an element to the front of the array
+     * @param value The value to add
+     */
+    void push_front(const T& value) {
+        insert(0, value);
+    }
+
+    /**
+     * @brief Remove the last element
+     * @throw std::runtime_error if the array is empty
+     */
+    void pop_back() {
+        if (empty()) {
+            throw std::runtime_error("Array is empty in pop_back()");
+        }
+        --length;
+        items[length].~T();
+    }
+
+    /**
+     * @brief Insert an element at a specific position
+     * @param pos The position to insert at
+     * @param value The value to insert
+     * @throw std::out_of_range if pos is out of range
+     */
+    void insert(size_t pos, const T& value) {
+        if (pos > length) {
+            throw std::out_of_range("Index out of range in insert()");
+        }
+        push_back(value);
+        std::rotate(items + pos, items + length - 1, items + length);
+    }
+
+    /**
+     * @brief Insert [first, last) before pos
+     * @param pos The position to insert at
+     * @param first Iterator to the first value to insert
+     * @param last Iterator past the last value to insert
+     * @throw std::out_of_range if pos is out of range
+     */
+    template <class ForwardIt, class = typename std::iterator_traits<ForwardIt>::iterator_category>
+    void insert(size_t pos, ForwardIt first, ForwardIt last) {
+        if (pos > length) {
+            throw std::out_of_range("Index out of range in insert()");
+        }
+        size_t old_length = length;
+        size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count > capacity - length) {
+            // The range may point into this array, so copy it into the new buffer
+            // before the old elements are relocated out from under it
+            size_t new_capacity = std::max(capacity * 2, length + count);
+            T* new_items = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
+            size_t built = 0;
+            try {
+                for (; first != last; ++first, ++built) {
+                    ::new (static_cast<void*>(new_items + length + built)) T(*first);
+                }
+            } catch (...) {
+                for (size_t i = 0; i < built; ++i) {
+                    new_items[length + i].~T();
+                }
+                ::operator delete(new_items);
+                throw;
+            }
+            relocate(new_items, items, length);
+            adopt_buffer(new_items, new_capacity);
+            length += count;
+        } else {
+            for (; first != last; ++first) {
+                ::new (static_cast<void*>(items + length)) T(*first);
+                ++length;
+            }
+        }
+        std::rotate(items + pos, items + old_length, items + length);
+    }
+
+    /**
+     * @brief Remove the element at a specific position
+     * @param pos The position to remove from
+     * @throw std::out_of_range if pos is out of range
+     */
+    void erase(size_t pos) {
+        if (pos >= length) {
+            throw std::out_of_range("Index out of range in erase()");
+        }
+        erase(pos, pos + 1);
+    }
+
+    /**
+     * @brief Remove the elements in [first, last)
+     * @param first The first position to remove
+     * @param last The position past the last one to remove
+     * @throw std::out_of_range if the range is invalid
+     */
+    void erase(size_t first, size_t last) {
+        if (first > last || last > length) {
+            throw std::out_of_range("Index out of range in erase()");
+        }
+        std::move(items + last, items + length, items + first);
+        size_t new_length = length - (last - first);
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (size_t i = new_length; i < length; ++i) {
+                items[i].~T();
+            }
+        }
+        length = new_length;
+    }
+
+    /**
+     * @brief Access an element by index
+     * @param pos The position of the element
+     * @return Reference to the element
+     * @throw std::out_of_range if pos is out of range
+     */
+    T& at(size_t pos) {
+        if (pos >= length) {
+            throw std::out_of_range("Index out of range in at()");
+        }
+        return items[pos];
+    }
+
+    /**
+     * @brief Access an element by index
+     * @param pos The position of the element
+     * @return Const reference to the element
+     * @throw std::out_of_range if pos is out of range
+     */
+    const T& at(size_t pos) const {
+        if (pos >= length) {
+            throw std::out_of_range("Index out of range in at()");
+        }
+        return items[pos];
+    }
+
+    /**
+     * @brief Replace the element at a specific position
+     * @param pos The position of the element
+     * @param value The new value
+     * @throw std::out_of_range if pos is out of range
+     */
+    void update_at(size_t pos, const T& value) {
+        at(pos) = value;
+    }
+
+    /**
+     * @brief Remove all elements; a spilled heap buffer is kept for reuse
+     */
+    void clear() noexcept {
+        destroy_all();
+    }
+
+    /**
+     * @brief Print the array contents to standard output
+     */
+    void print() const {
+        std::cout << "[ ";
+        for (size_t i = 0; i < length; ++i) {
+            std::cout << items[i] << ' ';
+        }
+        std::cout << ']' << std::endl;
+    }
+};
+
+#endif // SMALL_ARRAY_H
@@ -0,0 +1,318 @@
+/**
+ * @file SoA_Array.h
+ * @brief A structure-of-arrays container that stores each record field in its own column
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ */
+
+#ifndef SOA_ARRAY_H
+#define SOA_ARRAY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A contiguous view of one column
+ * @tparam T The column's element type
+ */
+template <class T>
+class Column_Span {
+private:
+    T* items;
+    size_t length;
+
+public:
+    Column_Span(T* items, size_t length) noexcept : items(items), length(length) {}
+
+    [[nodiscard]] T* data() const noexcept { return items; }
+    [[nodiscard]] size_t size() const noexcept { return length; }
+    [[nodiscard]] bool empty() const noexcept { return length == 0; }
+    T* begin() const noexcept { return items; }
+    T* end() const noexcept { return items + length; }
+    T& operator[](size_t index) const noexcept { return items[index]; }
+};
+
+/**
+ * @brief A record container laid out as one contiguous column per field
+ *
+ * SoA_Array<int, double, char> stores all ints together, all doubles together
+ * and all chars together, so a scan over one field reads only that field's
+ * memory. Columns are exposed as Column_Span for vectorized loops (for example
+ * with Simd_Search.h), and at(i) or operator[] return a proxy for per-record access.
+ *
+ * @tparam Fields The field types of one record, in column order
+ */
+template <class... Fields>
+class SoA_Array {
+private:
+    static_assert(sizeof...(Fields) > 0, "SoA_Array needs at least one field");
+    static_assert(!(std::is_same<Fields, bool>::value || ...), "SoA_Array cannot expose a contiguous bool column");
+
+    using Columns = std::tuple<std::vector<Fields>...>;
+    using Indices = std::index_sequence_for<Fields...>;
+
+    Columns columns;
+
+    // Appends to the columns one by one; if one of them throws, the columns
+    // already grown are cut back so every column keeps the same length
+    template <size_t... I>
+    void push_back_impl(std::index_sequence<I...>, const Fields&... values) {
+        size_t length = size();
+        try {
+            (std::get<I>(columns).push_back(values), ...);
+        } catch (...) {
+            truncate_impl(Indices{}, length);
+            throw;
+        }
+    }
+
+    // Appends, then rotates the new record into place, so a failed copy is
+    // rolled back by push_back_impl before any column has shifted
+    template <size_t... I>
+    void insert_impl(std::index_sequence<I...>, size_t pos, const Fields&... values) {
+        push_back_impl(Indices{}, values...);
+        (std::rotate(std::get<I>(columns).begin() + static_cast<std::ptrdiff_t>(pos),
+                     std::get<I>(columns).end() - 1, std::get<I>(columns).end()), ...);
+    }
+
+    template <size_t... I>
+    void truncate_impl(std::index_sequence<I...>, size_t length) noexcept {
+        (std::get<I>(columns).erase(std::get<I>(columns).begin() + static_cast<std::ptrdiff_t>(
+                                        std::min(length, std::get<I>(columns).size())),
+                                    std::get<I>(columns).end()), ...);
+    }
+
+    template <size_t... I>
+    void erase_impl(std::index_sequence<I...>, size_t first, size_t last) {
+        (std::get<I>(columns).erase(std::get<I>(columns).begin() + static_cast<std::ptrdiff_t>(first),
+                                    std::get<I>(columns).begin() + static_cast<std::ptrdiff_t>(last)), ...);
+    }
+
+    template <size_t... I>
+    void update_impl(std::index_sequence<I...>, size_t pos, const Fields&... values) {
+        ((std::get<I>(columns)[pos] = values), ...);
+    }
+
+    template <size_t... I>
+    void reserve_impl(std::index_sequence<I...>, size_t capacity) {
+        (std::get<I>(columns).reserve(capacity), ...);
+    }
+
+    template <size_t... I>
+    void clear_impl(std::index_sequence<I...>) noexcept {
+        (std::get<I>(columns).clear(), ...);
+    }
+
+public:
+    /**
+     * @brief Proxy for one record; reads and writes go straight to the columns
+     */
+    template <class Owner>
+    class Basic_Row {
+    private:
+        Owner* owner;
+        size_t index;
+
+        template <size_t... I>
+        std::tuple<Fields...> to_tuple(std::index_sequence<I...>) const {
+            return std::tuple<Fields...>(get<I>()...);
+        }
+
+    public:
+        Basic_Row(Owner* owner, size_t index) noexcept : owner(owner), index(index) {}
+
+        /**
+         * @brief Access one field of the record
+         * @tparam I The field's column index
+         */
+        template <size_t I>
+        decltype(auto) get() const {
+            return std::get<I>(owner->columns)[index];
+        }
+
+        /**
+         * @brief Copy the record out as a tuple
+         */
+        operator std::tuple<Fields...>() const {
+            return to_tuple(Indices{});
+        }
+
+        [[nodiscard]] size_t position() const noexcept {
+            return index;
+        }
+    };
+
+    using Row = Basic_Row<SoA_Array>;
+    using Const_Row = Basic_Row<const SoA_Array>;
+
+    /**
+     * @brief Default constructor
+     */
+    SoA_Array() = default;
+
+    /**
+     * @brief Get the number of records
+     * @return The number of records in the container
+     */
+    [[nodiscard]] size_t size() const noexcept {
+        return std::get<0>(columns).size();
+    }
+
+    /**
+     * @brief Get the number of records
+     * @return The number of records in the container
+     */
+    [[nodiscard]] size_t get_length() const noexcept {
+        return size();
+    }
+
+    /**
+     * @brief Check if the container is empty
+     * @return true if there are no records, false otherwise
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Reserve room in every column
+     * @param capacity The number of records to reserve
+     */
+    void reserve(size_t capacity) {
+        reserve_impl(Indices{}, capacity);
+    }
+
+    /**
+     * @brief Append a record; if copying a field throws, the container is left unchanged
+     * @param values One value per field
+     */
+    void push_back(const Fields&... values) {
+        push_back_impl(Indices{}, values...);
+    }
+
+    /**
+     * @brief Append a record given as a tuple
+     * @param record The record to append
+     */
+    void push_back(const std::tuple<Fields...>& record) {
+        std::apply([this](const Fields&... values) { push_back(values...); }, record);
+    }
+
+    /**
+     * @brief Insert a record at a specific position; if copying a field throws, the container is left unchanged
+     * @param pos The position to insert at
+     * @param values One value per field
+     * @throw std::out_of_range if pos is out of range
+     */
+    void insert(size_t pos, const Fields&... values) {
+        if (pos > size()) {
+            throw std::out_of_range("Index out of range in insert()");
+        }
+        insert_impl(Indices{}, pos, values...);
+    }
+
+    /**
+     * @brief Remove the record at a specific position
+     * @param pos The position to remove from
+     * @throw std::out_of_range if pos is out of range
+     */
+    void erase(size_t pos) {
+        if (pos >= size()) {
+            throw std::out_of_range("Index out of range in erase()");
+        }
+        erase_impl(Indices{}, pos, pos + 1);
+    }
+
+    /**
+     * @brief Remove the records in [first, last)
+     * @param first The first position to remove
+     * @param last The position past the last one to remove
+     * @throw std::out_of_range if the range is invalid
+     */
+    void erase(size_t first, size_t last) {
+        if (first > last || last > size()) {
+            throw std::out_of_range("Index out of range in erase()");
+        }
+        erase_impl(Indices{}, first, last);
+    }
+
+    /**
+     * @brief Remove all records
+     */
+    void clear() noexcept {
+        clear_impl(Indices{});
+    }
+
+    /**
+     * @brief Get a contiguous view of one column
+     * @tparam I The column index
+     */
+    template <size_t I>
+    [[nodiscard]] auto column() noexcept {
+        auto& items = std::get<I>(columns);
+        return Column_Span<typename std::tuple_element<I, std::tuple<Fields...>>::type>(items.data(), items.size());
+    }
+
+    /**
+     * @brief Get a read-only contiguous view of one column
+     * @tparam I The column index
+     */
+    template <size_t I>
+    [[nodiscard]] auto column() const noexcept {
+        const auto& items = std::get<I>(columns);
+        return Column_Span<const typename std::tuple_element<I, std::tuple<Fields...>>::type>(items.data(), items.size());
+    }
+
+    /**
+     * @brief Access a record without bounds checking
+     * @param pos The position of the record
+     */
+    Row operator[](size_t pos) noexcept {
+        return Row(this, pos);
+    }
+
+    Const_Row operator[](size_t pos) const noexcept {
+        return Const_Row(this, pos);
+    }
+
+    /**
+     * @brief Access a record by index
+     * @param pos The position of the record
+     * @return A proxy whose get<I>() reads or writes field I
+     * @throw std::out_of_range if pos is out of range
+     */
+    Row at(size_t pos) {
+        if (pos >= size()) {
+            throw std::out_of_range("Index out of range in at()");
+        }
+        return Row(this, pos);
+    }
+
+    Const_Row at(size_t pos) const {
+        if (pos >= size()) {
+            throw std::out_of_range("Index out of range in at()");
+        }
+        return Const_Row(this, pos);
+    }
+
+    /**
+     * @brief Replace the record at a specific position
+     * @param pos The position of the record
+     * @param values One value per field
+     * @throw std::out_of_range if pos is out of range
+     */
+    void update_at(size_t pos, const Fields&... values) {
+        if (pos >= size()) {
+            throw std::out_of_range("Index out of range in update_at()");
+        }
+        update_impl(Indices{}, pos, values...);
+    }
+};
+
+#endif // SOA_ARRAY_H
@@ -0,0 +1,269 @@
+/**
+ * @file Sorted_Array.h
+ * @brief A sorted array with binary search and an optional Eytzinger search index
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ */
+
+#ifndef SORTED_ARRAY_H
+#define SORTED_ARRAY_H
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Linked_List_Array.h"
+
+/**
+ * @brief An array kept in sorted order for repeated lookups
+ *
+ * Lookups use a branch-free binary search over the sorted elements. After
+ * build_index() they use an Eytzinger (BFS-order) copy instead: the first
+ * levels of the implicit tree share a few cache lines, and each step
+ * prefetches the line holding the node four levels down, so searches in
+ * arrays larger than L2 mostly hit cache. Modifying the array drops the index.
+ *
+ * @tparam T The type of elements stored in the array
+ * @tparam Compare Strict weak ordering used for sorting and searching
+ */
+template <class T, class Compare = std::less<T>>
+class Sorted_Array {
+private:
+    std::vector<T> items;
+    std::vector<T> eytzinger;    // 1-based BFS order; slot 0 is unused
+    std::vector<size_t> ranks;   // ranks[k] is the sorted index of eytzinger[k]
+    Compare comp;
+
+    static constexpr size_t prefetch_stride = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+
+    size_t fill_index(size_t next, size_t k) {
+        if (k < eytzinger.size()) {
+            next = fill_index(next, 2 * k);
+            eytzinger[k] = items[next];
+            ranks[k] = next;
+            ++next;
+            next = fill_index(next, 2 * k + 1);
+        }
+        return next;
+    }
+
+    // Drops the trailing 1-bits of k plus one more, i.e. climbs back to the
+    // node where the search last went left.
+    static size_t climb(size_t k) noexcept {
+#if defined(__GNUC__)
+        return k >> __builtin_ffsll(static_cast<long long>(~k));
+#else
+        while (k & 1) k >>= 1;
+        return k >> 1;
+#endif
+    }
+
+    template <class Less>
+    size_t eytzinger_search(Less less) const {
+        const T* tree = eytzinger.data();
+        const size_t n = eytzinger.size();
+        size_t k = 1;
+        while (k < n) {
+#if defined(__GNUC__)
+            __builtin_prefetch(tree + std::min(k * prefetch_stride, n - 1));
+#endif
+            k = 2 * k + static_cast<size_t>(less(tree[k]));
+        }
+        k = climb(k);
+        return k == 0 ? items.size() : ranks[k];
+    }
+
+    template <class Less>
+    size_t binary_search(Less less) const {
+        const T* base = items.data();
+        size_t len = items.size();
+        if (len == 0) return 0;
+        while (len > 1) {
+            size_t half = len / 2;
+            base += static_cast<size_t>(less(base[half - 1])) * half;
+            len -= half;
+        }
+        return static_cast<size_t>(base - items.data()) + static_cast<size_t>(less(*base));
+    }
+
+    template <class Less>
+    size_t search(Less less) const {
+        return has_index() ? eytzinger_search(less) : binary_search(less);
+    }
+
+public:
+    // Type definitions for STL compatibility
+    using value_type = T;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+
+    /**
+     * @brief Default constructor
+     * @param comp The ordering to use
+     */
+    explicit Sorted_Array(Compare comp = Compare()) : comp(comp) {}
+
+    /**
+     * @brief Construct from a range and sort it once
+     * @param first Iterator to the first element
+     * @param last Iterator past the last element
+     * @param comp The ordering to use
+     */
+    template <class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+    Sorted_Array(InputIt first, InputIt last, Compare comp = Compare()) : items(first, last), comp(comp) {
+        std::sort(items.begin(), items.end(), this->comp);
+    }
+
+    /**
+     * @brief Construct from an Array and sort it once
+     * @param array The array to copy
+     * @param comp The ordering to use
+     */
+    explicit Sorted_Array(Array<T>& array, Compare comp = Compare())
+        : Sorted_Array(array.data(), array.data() + array.get_length(), comp) {}
+
+    /**
+     * @brief Get the number of stored elements
+     * @return The number of elements in the array
+     */
+    [[nodiscard]] size_t size() const noexcept {
+        return items.size();
+    }
+
+    /**
+     * @brief Check if the array is empty
+     * @return true if the array is empty, false otherwise
+     */
+    [[nodiscard]] bool empty() const noexcept {
+        return items.empty();
+    }
+
+    /**
+     * @brief Access an element by sorted index
+     * @param pos The position of the element
+     * @return Const reference to the element
+     * @throw std::out_of_range if pos is out of range
+     */
+    const T& at(size_t pos) const {
+        if (pos >= items.size()) {
+            throw std::out_of_range("Index out of range in at()");
+        }
+        return items[pos];
+    }
+
+    const T* data() const noexcept {
+        return items.data();
+    }
+
+    /**
+     * @brief Build the Eytzinger search index used by all further lookups
+     */
+    void build_index() {
+        eytzinger.assign(items.size() + 1, T());
+        ranks.assign(items.size() + 1, 0);
+        fill_index(0, 1);
+    }
+
+    /**
+     * @brief Release the search index and fall back to binary search
+     */
+    void drop_index() noexcept {
+        eytzinger.clear();
+        eytzinger.shrink_to_fit();
+        ranks.clear();
+        ranks.shrink_to_fit();
+    }
+
+    /**
+     * @brief Check whether lookups use the Eytzinger index
+     */
+    [[nodiscard]] bool has_index() const noexcept {
+        return !eytzinger.empty();
+    }
+
+    /**
+     * @brief Insert an element at its sorted position; drops the search index
+     * @param value The value to insert
+     */
+    void insert(const T& value) {
+        drop_index();
+        items.insert(std::upper_bound(items.begin(), items.end(), value, comp), value);
+    }
+
+    /**
+     * @brief Remove the element at a sorted index; drops the search index
+     * @param pos The position to remove from
+     * @throw std::out_of_range if pos is out of range
+     */
+    void erase(size_t pos) {
+        if (pos >= items.size()) {
+            throw std::out_of_range("Index out of range in erase()");
+        }
+        drop_index();
+        items.erase(items.begin() + static_cast<std::ptrdiff_t>(pos));
+    }
+
+    /**
+     * @brief Remove all elements and the search index
+     */
+    void clear() noexcept {
+        items.clear();
+        drop_index();
+    }
+
+    /**
+     * @brief Find the first element not ordered before value
+     * @param value The value to search for
+     * @return Its sorted index, or size() if every element is smaller
+     */
+    [[nodiscard]] size_t lower_bound(const T& value) const {
+        return search([&](const T& item) { return comp(item, value); });
+    }
+
+    /**
+     * @brief Find the first element ordered after value
+     * @param value The value to search for
+     * @return Its sorted index, or size() if no element is larger
+     */
+    [[nodiscard]] size_t upper_bound(const T& value) const {
+        return search([&](const T& item) { return !comp(value, item); });
+    }
+
+    /**
+     * @brief Find the range of elements equivalent to value
+     * @param value The value to search for
+     * @return [lower_bound(value), upper_bound(value))
+     */
+    [[nodiscard]] std::pair<size_t, size_t> equal_range(const T& value) const {
+        return {lower_bound(value), upper_bound(value)};
+    }
+
+    /**
+     * @brief Check whether an element equivalent to value is stored
+     * @param value The value to search for
+     * @return true if found, false otherwise
+     */
+    [[nodiscard]] bool contains(const T& value) const {
+        size_t pos = lower_bound(value);
+        return pos < items.size() && !comp(value, items[pos]);
+    }
+
+    /**
+     * @brief Print the array contents to standard output
+     */
+    void print() const {
+        std::cout << "[ ";
+        for (const T& item : items) {
+            std::cout << item << ' ';
+        }
+        std::cout << ']' << std::endl;
+    }
+};
+
+#endif // SORTED_ARRAY_H
@@ -0,0 +1,253 @@
+/**
+ * @file Thread_Pool.h
+ * @brief A small work-stealing thread pool and fork-join task groups
+ * @author Eyadd
+ * @date 2026-10-19
+ * @version 1.0
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A fixed set of worker threads, each with its own task deque
+ *
+ * A worker pushes and pops its own tasks at the back of its deque (LIFO keeps
+ * recently split work hot in cache) and, when it runs dry, steals from the
+ * front of another worker's deque. Threads outside the pool submit round-robin.
+ * Waiting threads call run_pending_task() to help instead of blocking, which
+ * keeps nested fork-join from deadlocking.
+ */
+class Thread_Pool {
+private:
+    struct Worker_Queue {
+        std::mutex lock;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker_Queue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> queued;
+    std::atomic<size_t> next_queue;
+    std::mutex sleep_lock;
+    std::condition_variable wake;
+    bool stopping;
+
+    static size_t& current_index() {
+        thread_local size_t index = static_cast<size_t>(-1);
+        return index;
+    }
+
+    static Thread_Pool*& current_pool() {
+        thread_local Thread_Pool* pool = nullptr;
+        return pool;
+    }
+
+    bool try_pop(size_t home, std::function<void()>& task) {
+        size_t count = queues.size();
+        if (home < count) {
+            Worker_Queue& own = *queues[home];
+            std::lock_guard<std::mutex> guard(own.lock);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        size_t start = home < count ? home + 1 : next_queue.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < count; ++i) {
+            Worker_Queue& victim = *queues[(start + i) % count];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker_loop(size_t index) {
+        current_index() = index;
+        current_pool() = this;
+        std::function<void()> task;
+        while (true) {
+            if (try_pop(index, task)) {
+                queued.fetch_sub(1, std::memory_order_relaxed);
+                task();
+                task = nullptr;
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(sleep_lock);
+            wake.wait(guard, [this] { return stopping || queued.load() != 0; });
+            if (stopping && queued.load() == 0) {
+                return;
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Start the worker threads
+     * @param thread_count Number of workers; 0 means one per hardware thread
+     */
+    explicit Thread_Pool(size_t thread_count = 0) : queued(0), next_queue(0), stopping(false) {
+        if (thread_count == 0) {
+            thread_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        }
+        for (size_t i = 0; i < thread_count; ++i) {
+            queues.push_back(std::make_unique<Worker_Queue>());
+        }
+        for (size_t i = 0; i < thread_count; ++i) {
+            threads.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    Thread_Pool(const Thread_Pool&) = delete;
+    Thread_Pool& operator=(const Thread_Pool&) = delete;
+
+    /**
+     * @brief Finish the queued tasks and join the workers
+     */
+    ~Thread_Pool() {
+        {
+            std::lock_guard<std::mutex> guard(sleep_lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    /**
+     * @brief Get the number of worker threads
+     */
+    [[nodiscard]] size_t size() const noexcept {
+        return threads.size();
+    }
+
+    /**
+     * @brief Queue a task; a worker submitting to its own pool keeps it local
+     * @param task The callable to run
+     */
+    template <class F>
+    void submit(F&& task) {
+        size_t index = current_pool() == this ? current_index()
+                                              : next_queue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        // Counted under the sleep lock before the push so a worker can never
+        // miss the wake-up or see the count drop below zero
+        {
+            std::lock_guard<std::mutex> guard(sleep_lock);
+            queued.fetch_add(1);
+        }
+        {
+            Worker_Queue& queue = *queues[index];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            queue.tasks.emplace_back(std::forward<F>(task));
+        }
+        wake.notify_one();
+    }
+
+    /**
+     * @brief Run one queued task on the calling thread, if there is one
+     * @return true if a task ran
+     */
+    bool run_pending_task() {
+        std::function<void()> task;
+        size_t home = current_pool() == this ? current_index() : static_cast<size_t>(-1);
+        if (!try_pop(home, task)) {
+            return false;
+        }
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        task();
+        return true;
+    }
+
+    /**
+     * @brief Get the process-wide pool with one worker per hardware thread
+     */
+    static Thread_Pool& shared() {
+        static Thread_Pool pool;
+        return pool;
+    }
+};
+
+/**
+ * @brief Runs tasks on a pool and waits for all of them
+ *
+ * wait() executes queued tasks while it waits and rethrows the first
+ * exception any task threw. Call wait() before the group goes out of scope:
+ * the destructor still waits for the tasks, but it cannot throw, so a task's
+ * exception that wait() never collected is lost. Debug builds assert on that,
+ * except while another exception is already unwinding the stack.
+ */
+class Task_Group {
+private:
+    Thread_Pool& pool;
+    std::atomic<size_t> pending;
+    std::mutex error_lock;
+    std::exception_ptr error;
+
+public:
+    explicit Task_Group(Thread_Pool& pool) : pool(pool), pending(0) {}
+
+    Task_Group(const Task_Group&) = delete;
+    Task_Group& operator=(const Task_Group&) = delete;
+
+    ~Task_Group() {
+        while (pending.load(std::memory_order_acquire) != 0) {
+            if (!pool.run_pending_task()) std::this_thread::yield();
+        }
+        assert((!error || std::uncaught_exceptions() > 0) && "Task_Group destroyed with a task error wait() never saw");
+    }
+
+    /**
+     * @brief Run a task on the pool as part of this group
+     * @param task The callable to run
+     */
+    template <class F>
+    void run(F&& task) {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        pool.submit([this, task = std::forward<F>(task)]() mutable {
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(error_lock);
+                if (!error) error = std::current_exception();
+            }
+            pending.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    /**
+     * @brief Wait for every task in the group, helping with queued work meanwhile
+     * @throw Whatever the first failing task threw
+     */
+    void wait() {
+        while (pending.load(std::memory_order_acquire) != 0) {
+            if (!pool.run_pending_task()) std::this_thread::yield();
+        }
+        if (error) {
+            std::exception_ptr first = error;
+            error = nullptr;
+            std::rethrow_exception(first);
+        }
+    }
+};
+
+#endif // THREAD_POOL_H
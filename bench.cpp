@@ -0,0 +1,1467 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <stack>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include "Linked_List.h"
+#include "Doubly_Linked_List.h"
+#include "Array_Queue.h"
+#include "Linked_Queue.h"
+#include "Linked_Stack.h"
+#include "Linked_List_Array.h"
+#include "Simd_Search.h"
+#include "Sorted_Array.h"
+#include "Packed_Array.h"
+#include "Parallel.h"
+#include "Radix_Sort.h"
+#include "Calc.h"
+#include "Calc_Program.h"
+#include "Calc_Batch.h"
+#include "Calc_Columns.h"
+#include "Calc_Cache.h"
+#include "Calc_Optimizer.h"
+#include "Calc_Sheet.h"
+#include "Calc_Stream.h"
+#include "Perf_Counters.h"
+#include "Latency_Histogram.h"
+
+// Keeps the optimizer from discarding a benchmarked result
+template <class T>
+void do_not_optimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static_cast<void>(*reinterpret_cast<const volatile char*>(&value));
+#endif
+}
+
+// Hardware counters read around every timed region, or null with --no-counters
+Perf_Counters* bench_counters = nullptr;
+// Counts per element of the last time_per_element() or time_fresh(); NaN when not counted
+Perf_Sample last_counters;
+
+void counters_begin() {
+    if (bench_counters != nullptr) bench_counters->reset();
+}
+
+void counters_end(size_t operations) {
+    last_counters = bench_counters != nullptr ? bench_counters->sample().per(static_cast<double>(operations))
+                                              : Perf_Sample();
+}
+
+// Runs op until at least 50ms have passed and returns nanoseconds per element
+template <class Op>
+double time_per_element(size_t elements, Op op) {
+    using clock = std::chrono::steady_clock;
+    size_t iterations = 0;
+    counters_begin();
+    if (bench_counters != nullptr) bench_counters->start();
+    auto start = clock::now();
+    auto elapsed = clock::duration::zero();
+    do {
+        op();
+        ++iterations;
+        elapsed = clock::now() - start;
+    } while (elapsed < std::chrono::milliseconds(50));
+    if (bench_counters != nullptr) bench_counters->stop();
+    counters_end(iterations * elements);
+    double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    return ns / static_cast<double>(iterations * elements);
+}
+
+void print_result(const std::string& name, size_t size, double scalar_ns, double simd_ns) {
+    std::cout << std::left << std::setw(14) << name << std::right << std::setw(12) << size
+              << std::fixed << std::setprecision(3) << std::setw(12) << scalar_ns << std::setw(12) << simd_ns
+              << std::setprecision(2) << std::setw(9) << scalar_ns / simd_ns << 'x' << std::endl;
+}
+
+// One measurement kept for --json
+struct Bench_Record {
+    std::string suite;
+    std::string operation;
+    std::string variant;
+    size_t size;
+    double ns;
+    Perf_Sample counters;
+    // Per-call percentiles in ns, for suites that time every call
+    bool has_latency = false;
+    uint64_t latency[4] = {0, 0, 0, 0};
+};
+
+std::vector<Bench_Record> bench_records;
+
+void record_result(const std::string& suite, const std::string& operation, const std::string& variant, size_t size,
+                   double ns, const Perf_Sample& counters = Perf_Sample()) {
+    bench_records.push_back(Bench_Record{suite, operation, variant, size, ns, counters});
+}
+
+const double latency_percentiles[4] = {50, 99, 99.9, 100};
+const char* const latency_names[4] = {"p50_ns", "p99_ns", "p99_9_ns", "max_ns"};
+
+void record_latency(const std::string& suite, const std::string& operation, const std::string& variant,
+                    const Latency_Histogram& histogram) {
+    Bench_Record record{suite, operation, variant, static_cast<size_t>(histogram.count()), histogram.mean(),
+                        Perf_Sample()};
+    record.has_latency = true;
+    for (size_t i = 0; i < 4; ++i) {
+        record.latency[i] = histogram.percentile(latency_percentiles[i]);
+    }
+    bench_records.push_back(record);
+}
+
+// Writes every recorded measurement as a JSON array; the names are plain identifiers, so nothing
+// needs escaping. Counters are per operation and null where they were not read; latency
+// records carry their percentiles too.
+bool write_json(const std::string& path) {
+    std::ofstream out(path);
+    out << "[\n";
+    for (size_t i = 0; i < bench_records.size(); ++i) {
+        const Bench_Record& record = bench_records[i];
+        out << "  {\"suite\": \"" << record.suite << "\", \"operation\": \"" << record.operation
+            << "\", \"variant\": \"" << record.variant << "\", \"size\": " << record.size
+            << ", \"ns_per_op\": " << std::setprecision(6) << record.ns;
+        for (size_t event = 0; event < perf_event_count; ++event) {
+            out << ", \"" << perf_event_name(static_cast<Perf_Event>(event)) << "\": ";
+            if (std::isnan(record.counters.counts[event])) {
+                out << "null";
+            } else {
+                out << record.counters.counts[event];
+            }
+        }
+        if (record.has_latency) {
+            for (size_t p = 0; p < 4; ++p) {
+                out << ", \"" << latency_names[p] << "\": " << record.latency[p];
+            }
+        }
+        out << '}'
+            << (i + 1 < bench_records.size() ? "," : "") << '\n';
+    }
+    out << "]\n";
+    return static_cast<bool>(out);
+}
+
+// Times op on fresh containers from make, leaving out building and destroying them,
+// and returns nanoseconds per element. Small containers are made in batches of
+// about 10^5 elements so the clock reads do not dominate.
+template <class Make, class Op>
+double time_fresh(size_t size, size_t elements, Make make, Op op) {
+    using clock = std::chrono::steady_clock;
+    size_t batch = std::max<size_t>(1, 100000 / std::max<size_t>(size, 1));
+    size_t iterations = 0;
+    auto elapsed = clock::duration::zero();
+    counters_begin();
+    do {
+        std::vector<decltype(make())> fresh;
+        fresh.reserve(batch);
+        for (size_t i = 0; i < batch; ++i) {
+            fresh.push_back(make());
+        }
+        if (bench_counters != nullptr) bench_counters->start();
+        auto start = clock::now();
+        for (auto& container : fresh) {
+            op(*container);
+        }
+        elapsed += clock::now() - start;
+        if (bench_counters != nullptr) bench_counters->stop();
+        iterations += batch;
+    } while (elapsed < std::chrono::milliseconds(50));
+    counters_end(iterations * elements);
+    double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    return ns / static_cast<double>(iterations * elements);
+}
+
+// Container sizes: powers of ten from 10 up to max_size, at most 10^7
+std::vector<size_t> container_sizes(size_t max_size) {
+    std::vector<size_t> sizes;
+    for (size_t size = 10; size <= std::min<size_t>(max_size, 10000000); size *= 10) {
+        sizes.push_back(size);
+    }
+    return sizes;
+}
+
+void container_header(const std::string& operation, const std::string& unit, const std::vector<size_t>& sizes) {
+    std::cout << '\n' << operation << " (ns/" << unit << ")" << std::endl;
+    std::cout << std::left << std::setw(20) << "container" << std::right;
+    for (size_t size : sizes) {
+        std::cout << std::setw(13) << size;
+    }
+    std::cout << std::endl;
+}
+
+// Prints and records one container's cost at every size up to limit; larger sizes print "-".
+// Each hardware counter that could be read gets a line of its own per-element counts below.
+template <class Measure>
+void container_row(const std::string& operation, const std::string& container, const std::vector<size_t>& sizes,
+                   size_t limit, Measure measure) {
+    std::vector<Perf_Sample> samples;
+    std::cout << std::left << std::setw(20) << container << std::right << std::fixed << std::setprecision(2);
+    for (size_t size : sizes) {
+        if (size > limit) {
+            std::cout << std::setw(13) << '-';
+            continue;
+        }
+        double ns = measure(size);
+        samples.push_back(last_counters);
+        record_result("containers", operation, container, size, ns, last_counters);
+        std::cout << std::setw(13) << ns << std::flush;
+    }
+    std::cout << std::endl;
+
+    for (size_t event = 0; event < perf_event_count; ++event) {
+        // An event can go unscheduled for one size and not another; those cells print nan
+        if (std::none_of(samples.begin(), samples.end(),
+                         [event](const Perf_Sample& sample) { return sample.has(static_cast<Perf_Event>(event)); })) {
+            continue;
+        }
+        std::cout << "  " << std::left << std::setw(18) << perf_event_name(static_cast<Perf_Event>(event))
+                  << std::right;
+        for (const Perf_Sample& sample : samples) {
+            std::cout << std::setw(13) << sample.counts[event];
+        }
+        std::cout << std::endl;
+    }
+}
+
+// Builders for the containers under test, each holding 0 .. size-1
+template <class List>
+std::unique_ptr<List> make_list(size_t size) {
+    std::unique_ptr<List> list(new List());
+    for (size_t i = 0; i < size; ++i) {
+        list->push_back(static_cast<int>(i));
+    }
+    return list;
+}
+
+std::unique_ptr<Array<int>> make_array(size_t size, size_t capacity) {
+    std::unique_ptr<Array<int>> array(new Array<int>(capacity));
+    for (size_t i = 0; i < size; ++i) {
+        array->push_back(static_cast<int>(i));
+    }
+    return array;
+}
+
+// Operations that run in linear time per call stop at this size
+constexpr size_t linear_op_limit = 1000000;
+// Middle inserts and erases timed on each fresh container
+constexpr size_t middle_ops = 16;
+
+void bench_container_push(const std::vector<size_t>& sizes) {
+    container_header("push_back", "element", sizes);
+    auto push_back = [](auto make) {
+        return [make](size_t size) {
+            return time_fresh(size, size, make, [size](auto& container) {
+                for (size_t i = 0; i < size; ++i) container.push_back(static_cast<int>(i));
+            });
+        };
+    };
+    container_row("push_back", "Single_Linked_List", sizes, SIZE_MAX,
+                  push_back([] { return make_list<Single_Linked_List<int>>(0); }));
+    container_row("push_back", "Doubly_Linked_List", sizes, SIZE_MAX,
+                  push_back([] { return make_list<Doubly_Linked_List<int>>(0); }));
+    container_row("push_back", "std::list", sizes, SIZE_MAX, push_back([] { return make_list<std::list<int>>(0); }));
+    container_row("push_back", "std::deque", sizes, SIZE_MAX, push_back([] { return make_list<std::deque<int>>(0); }));
+    container_row("push_back", "std::vector", sizes, SIZE_MAX,
+                  push_back([] { return make_list<std::vector<int>>(0); }));
+    // Array has a fixed capacity, so it is sized up front
+    container_row("push_back", "Array", sizes, SIZE_MAX, [](size_t size) {
+        return time_fresh(size, size, [size] { return make_array(0, size); }, [size](Array<int>& array) {
+            for (size_t i = 0; i < size; ++i) array.push_back(static_cast<int>(i));
+        });
+    });
+
+    container_header("push_front", "element", sizes);
+    auto push_front = [](auto make, size_t size) {
+        return time_fresh(size, size, make, [size](auto& container) {
+            for (size_t i = 0; i < size; ++i) container.push_front(static_cast<int>(i));
+        });
+    };
+    container_row("push_front", "Single_Linked_List", sizes, SIZE_MAX, [&](size_t size) {
+        return push_front([] { return make_list<Single_Linked_List<int>>(0); }, size);
+    });
+    container_row("push_front", "Doubly_Linked_List", sizes, SIZE_MAX, [&](size_t size) {
+        return push_front([] { return make_list<Doubly_Linked_List<int>>(0); }, size);
+    });
+    container_row("push_front", "std::list", sizes, SIZE_MAX, [&](size_t size) {
+        return push_front([] { return make_list<std::list<int>>(0); }, size);
+    });
+    container_row("push_front", "std::deque", sizes, SIZE_MAX, [&](size_t size) {
+        return push_front([] { return make_list<std::deque<int>>(0); }, size);
+    });
+    // Every Array push_front shifts the whole array, so filling one is quadratic
+    container_row("push_front", "Array", sizes, 10000, [&](size_t size) {
+        return push_front([size] { return make_array(0, size); }, size);
+    });
+
+    container_header("pop_front", "element", sizes);
+    auto pop_front = [](auto make, size_t size) {
+        return time_fresh(size, size, make, [size](auto& container) {
+            for (size_t i = 0; i < size; ++i) container.pop_front();
+        });
+    };
+    container_row("pop_front", "Single_Linked_List", sizes, SIZE_MAX, [&](size_t size) {
+        return pop_front([size] { return make_list<Single_Linked_List<int>>(size); }, size);
+    });
+    container_row("pop_front", "Doubly_Linked_List", sizes, SIZE_MAX, [&](size_t size) {
+        return pop_front([size] { return make_list<Doubly_Linked_List<int>>(size); }, size);
+    });
+    container_row("pop_front", "std::list", sizes, SIZE_MAX, [&](size_t size) {
+        return pop_front([size] { return make_list<std::list<int>>(size); }, size);
+    });
+    container_row("pop_front", "std::deque", sizes, SIZE_MAX, [&](size_t size) {
+        return pop_front([size] { return make_list<std::deque<int>>(size); }, size);
+    });
+}
+
+// Insert and erase at the middle; each costs a walk or a shift proportional to the size
+void bench_container_middle(const std::vector<size_t>& sizes) {
+    container_header("insert middle", "insert", sizes);
+    auto list_insert = [](auto make, size_t size) {
+        return time_fresh(size, middle_ops, make, [size](auto& list) {
+            for (size_t i = 0; i < middle_ops; ++i) list.insert(size / 2, static_cast<int>(i));
+        });
+    };
+    auto std_insert = [](auto make, size_t size) {
+        return time_fresh(size, middle_ops, make, [size](auto& container) {
+            for (size_t i = 0; i < middle_ops; ++i) {
+                container.insert(std::next(container.begin(), static_cast<std::ptrdiff_t>(size / 2)),
+                                 static_cast<int>(i));
+            }
+        });
+    };
+    container_row("insert_middle", "Single_Linked_List", sizes, linear_op_limit, [&](size_t size) {
+        return list_insert([size] { return make_list<Single_Linked_List<int>>(size); }, size);
+    });
+    container_row("insert_middle", "Doubly_Linked_List", sizes, linear_op_limit, [&](size_t size) {
+        return list_insert([size] { return make_list<Doubly_Linked_List<int>>(size); }, size);
+    });
+    container_row("insert_middle", "Array", sizes, linear_op_limit, [&](size_t size) {
+        return list_insert([size] { return make_array(size, size + middle_ops); }, size);
+    });
+    container_row("insert_middle", "std::list", sizes, linear_op_limit, [&](size_t size) {
+        return std_insert([size] { return make_list<std::list<int>>(size); }, size);
+    });
+    container_row("insert_middle", "std::deque", sizes, linear_op_limit, [&](size_t size) {
+        return std_insert([size] { return make_list<std::deque<int>>(size); }, size);
+    });
+    container_row("insert_middle", "std::vector", sizes, linear_op_limit, [&](size_t size) {
+        return std_insert([size] { return make_list<std::vector<int>>(size); }, size);
+    });
+
+    container_header("erase middle", "erase", sizes);
+    auto list_erase = [](auto make, size_t size) {
+        return time_fresh(size, middle_ops, make, [size](auto& list) {
+            for (size_t i = 0; i < middle_ops; ++i) list.erase(size / 4);
+        });
+    };
+    auto std_erase = [](auto make, size_t size) {
+        return time_fresh(size, middle_ops, make, [size](auto& container) {
+            for (size_t i = 0; i < middle_ops; ++i) {
+                container.erase(std::next(container.begin(), static_cast<std::ptrdiff_t>(size / 4)));
+            }
+        });
+    };
+    // Erasing at a quarter keeps the position valid for the smallest size
+    container_row("erase_middle", "Single_Linked_List", sizes, linear_op_limit, [&](size_t size) {
+        return list_erase([size] { return make_list<Single_Linked_List<int>>(size + middle_ops); }, size);
+    });
+    container_row("erase_middle", "Doubly_Linked_List", sizes, linear_op_limit, [&](size_t size) {
+        return list_erase([size] { return make_list<Doubly_Linked_List<int>>(size + middle_ops); }, size);
+    });
+    container_row("erase_middle", "Array", sizes, linear_op_limit, [&](size_t size) {
+        return list_erase([size] { return make_array(size + middle_ops, size + middle_ops); }, size);
+    });
+    container_row("erase_middle", "std::list", sizes, linear_op_limit, [&](size_t size) {
+        return std_erase([size] { return make_list<std::list<int>>(size + middle_ops); }, size);
+    });
+    container_row("erase_middle", "std::deque", sizes, linear_op_limit, [&](size_t size) {
+        return std_erase([size] { return make_list<std::deque<int>>(size + middle_ops); }, size);
+    });
+    container_row("erase_middle", "std::vector", sizes, linear_op_limit, [&](size_t size) {
+        return std_erase([size] { return make_list<std::vector<int>>(size + middle_ops); }, size);
+    });
+}
+
+// Sums every element by iteration
+template <class Container>
+long iterate_sum(Container& container) {
+    long sum = 0;
+    for (auto it = container.begin(); it != container.end(); ++it) {
+        sum += *it;
+    }
+    return sum;
+}
+
+// Finds a value that is not there, so every element is compared
+template <class Container>
+bool iterate_find(Container& container, int value) {
+    for (auto it = container.begin(); it != container.end(); ++it) {
+        if (*it == value) return true;
+    }
+    return false;
+}
+
+// Read-only scans over a list built once per size
+void bench_container_scan(const std::vector<size_t>& sizes) {
+    auto scan = [](auto make, auto op) {
+        return [make, op](size_t size) {
+            auto container = make(size);
+            return time_per_element(size, [&] { do_not_optimize(op(*container)); });
+        };
+    };
+    auto sum = [](auto& container) { return iterate_sum(container); };
+    auto find_missing = [](auto& container) { return iterate_find(container, -1); };
+
+    container_header("iterate", "element", sizes);
+    container_row("iterate", "Single_Linked_List", sizes, SIZE_MAX, scan(make_list<Single_Linked_List<int>>, sum));
+    container_row("iterate", "Doubly_Linked_List", sizes, SIZE_MAX, scan(make_list<Doubly_Linked_List<int>>, sum));
+    container_row("iterate", "Array", sizes, SIZE_MAX,
+                  scan([](size_t size) { return make_array(size, size); }, [](Array<int>& array) {
+                      const int* data = array.data();
+                      long total = 0;
+                      for (size_t i = 0; i < array.get_length(); ++i) total += data[i];
+                      return total;
+                  }));
+    container_row("iterate", "std::list", sizes, SIZE_MAX, scan(make_list<std::list<int>>, sum));
+    container_row("iterate", "std::deque", sizes, SIZE_MAX, scan(make_list<std::deque<int>>, sum));
+    container_row("iterate", "std::vector", sizes, SIZE_MAX, scan(make_list<std::vector<int>>, sum));
+
+    container_header("find missing", "element", sizes);
+    container_row("find", "Single_Linked_List", sizes, SIZE_MAX,
+                  scan(make_list<Single_Linked_List<int>>, [](Single_Linked_List<int>& list) { return list.find(-1); }));
+    container_row("find", "Doubly_Linked_List", sizes, SIZE_MAX, scan(make_list<Doubly_Linked_List<int>>, find_missing));
+    container_row("find", "Array", sizes, SIZE_MAX,
+                  scan([](size_t size) { return make_array(size, size); }, [](Array<int>& array) {
+                      const int* data = array.data();
+                      return std::find(data, data + array.get_length(), -1) != data + array.get_length();
+                  }));
+    container_row("find", "std::list", sizes, SIZE_MAX, scan(make_list<std::list<int>>, find_missing));
+    container_row("find", "std::deque", sizes, SIZE_MAX, scan(make_list<std::deque<int>>, find_missing));
+    container_row("find", "std::vector", sizes, SIZE_MAX, scan(make_list<std::vector<int>>, find_missing));
+}
+
+// Queue and stack adapters: fill to size, then drain
+void bench_container_adapters(const std::vector<size_t>& sizes) {
+    auto fill = [](auto make, auto push) {
+        return [make, push](size_t size) {
+            return time_fresh(size, size, [make, size] { return make(size); }, [push, size](auto& container) {
+                for (size_t i = 0; i < size; ++i) push(container, static_cast<int>(i));
+            });
+        };
+    };
+    auto drain = [](auto make, auto push, auto pop) {
+        return [make, push, pop](size_t size) {
+            auto full = [make, push, size] {
+                auto container = make(size);
+                for (size_t i = 0; i < size; ++i) push(*container, static_cast<int>(i));
+                return container;
+            };
+            return time_fresh(size, size, full, [pop, size](auto& container) {
+                for (size_t i = 0; i < size; ++i) pop(container);
+            });
+        };
+    };
+    auto make_array_queue = [](size_t size) { return std::unique_ptr<Array_Queue<int>>(new Array_Queue<int>(size)); };
+    auto make_linked_queue = [](size_t) { return std::unique_ptr<Linked_Queue<int>>(new Linked_Queue<int>()); };
+    auto make_std_queue = [](size_t) { return std::unique_ptr<std::queue<int>>(new std::queue<int>()); };
+    auto enqueue = [](auto& queue, int value) { queue.enqueue(value); };
+    auto dequeue = [](auto& queue) { queue.dequeue(); };
+    auto std_push = [](auto& adapter, int value) { adapter.push(value); };
+    auto std_pop = [](auto& adapter) { adapter.pop(); };
+
+    container_header("queue enqueue", "element", sizes);
+    container_row("enqueue", "Array_Queue", sizes, SIZE_MAX, fill(make_array_queue, enqueue));
+    container_row("enqueue", "Linked_Queue", sizes, SIZE_MAX, fill(make_linked_queue, enqueue));
+    container_row("enqueue", "std::queue", sizes, SIZE_MAX, fill(make_std_queue, std_push));
+
+    container_header("queue dequeue", "element", sizes);
+    container_row("dequeue", "Array_Queue", sizes, SIZE_MAX, drain(make_array_queue, enqueue, dequeue));
+    container_row("dequeue", "Linked_Queue", sizes, SIZE_MAX, drain(make_linked_queue, enqueue, dequeue));
+    container_row("dequeue", "std::queue", sizes, SIZE_MAX, drain(make_std_queue, std_push, std_pop));
+
+    auto make_linked_stack = [](size_t) { return std::unique_ptr<Linked_Stack<int>>(new Linked_Stack<int>()); };
+    auto make_std_stack = [](size_t) { return std::unique_ptr<std::stack<int>>(new std::stack<int>()); };
+    auto make_vector_stack = [](size_t) {
+        return std::unique_ptr<std::stack<int, std::vector<int>>>(new std::stack<int, std::vector<int>>());
+    };
+
+    container_header("stack push", "element", sizes);
+    container_row("push", "Linked_Stack", sizes, SIZE_MAX, fill(make_linked_stack, std_push));
+    container_row("push", "std::stack", sizes, SIZE_MAX, fill(make_std_stack, std_push));
+    container_row("push", "std::stack<vector>", sizes, SIZE_MAX, fill(make_vector_stack, std_push));
+
+    container_header("stack pop", "element", sizes);
+    container_row("pop", "Linked_Stack", sizes, SIZE_MAX, drain(make_linked_stack, std_push, std_pop));
+    container_row("pop", "std::stack", sizes, SIZE_MAX, drain(make_std_stack, std_push, std_pop));
+    container_row("pop", "std::stack<vector>", sizes, SIZE_MAX, drain(make_vector_stack, std_push, std_pop));
+}
+
+// Benchmark every container against its closest standard library counterpart
+void bench_containers(size_t max_size) {
+    std::vector<size_t> sizes = container_sizes(max_size);
+    std::cout << "\nContainers against the standard library" << std::endl;
+    bench_container_push(sizes);
+    bench_container_middle(sizes);
+    bench_container_scan(sizes);
+    bench_container_adapters(sizes);
+}
+
+// Prints and records the percentiles of one histogram of per-call latencies
+void latency_row(const std::string& operation, const std::string& container, const Latency_Histogram& histogram) {
+    record_latency("latency", operation, container, histogram);
+    std::cout << std::left << std::setw(10) << operation << std::setw(24) << container << std::right << std::setw(10)
+              << histogram.count() << std::fixed << std::setprecision(1) << std::setw(9) << histogram.mean();
+    for (double percent : latency_percentiles) {
+        std::cout << std::setw(11) << histogram.percentile(percent);
+    }
+    std::cout << std::endl;
+}
+
+// Fills a queue with count values and drains it, timing every call
+template <class Queue, class... Args>
+void latency_queue(const std::string& name, size_t count, Args... args) {
+    Timed_Queue<Queue> queue(args...);
+    for (size_t i = 0; i < count; ++i) queue.enqueue(static_cast<int>(i));
+    for (size_t i = 0; i < count; ++i) queue.dequeue();
+    latency_row("enqueue", name, queue.enqueue_latency());
+    latency_row("dequeue", name, queue.dequeue_latency());
+}
+
+// The same for anything with push and pop; the standard adapters report under the given names
+template <class Stack>
+void latency_stack(const std::string& name, size_t count, const std::string& push_name = "push",
+                   const std::string& pop_name = "pop") {
+    Timed_Stack<Stack> stack;
+    for (size_t i = 0; i < count; ++i) stack.push(static_cast<int>(i));
+    for (size_t i = 0; i < count; ++i) stack.pop();
+    latency_row(push_name, name, stack.push_latency());
+    latency_row(pop_name, name, stack.pop_latency());
+}
+
+// Threads sharing one Array_Queue behind a mutex, each enqueueing and then dequeueing. The
+// time to take the lock is part of each call; every thread records into its own histograms
+// and they are merged at the end.
+void latency_contended(size_t count) {
+    size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 2);
+    Array_Queue<int> queue(static_cast<unsigned>(threads));
+    std::mutex mutex;
+    std::vector<Latency_Histogram> enqueues(threads);
+    std::vector<Latency_Histogram> dequeues(threads);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (size_t i = 0; i < count / threads; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    queue.enqueue(static_cast<int>(i));
+                }
+                enqueues[t].record_since(start);
+                // Every thread enqueues before it dequeues, so the queue is never empty here
+                int value = 0;
+                start = std::chrono::steady_clock::now();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    queue.dequeue(value);
+                }
+                dequeues[t].record_since(start);
+                do_not_optimize(value);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (size_t t = 1; t < threads; ++t) {
+        enqueues[0].merge(enqueues[t]);
+        dequeues[0].merge(dequeues[t]);
+    }
+    std::string name = "Array_Queue+mutex x" + std::to_string(threads);
+    latency_row("enqueue", name, enqueues[0]);
+    latency_row("dequeue", name, dequeues[0]);
+}
+
+// Benchmark the latency distribution of single queue and stack calls, tail included
+void bench_latency(size_t max_size) {
+    size_t count = std::min<size_t>(max_size, 1000000);
+    std::cout << "\nPer-call latency over " << count << " calls (ns, log-bucketed histograms)" << std::endl;
+    std::cout << std::left << std::setw(10) << "operation" << std::setw(24) << "container" << std::right
+              << std::setw(10) << "calls" << std::setw(9) << "mean" << std::setw(11) << "p50" << std::setw(11)
+              << "p99" << std::setw(11) << "p99.9" << std::setw(11) << "max" << std::endl;
+
+    // What timing an empty call costs; every other row includes this
+    Latency_Histogram clock_cost;
+    for (size_t i = 0; i < count; ++i) {
+        clock_cost.record_since(std::chrono::steady_clock::now());
+    }
+    latency_row("nothing", "steady_clock", clock_cost);
+
+    latency_queue<Array_Queue<int>>("Array_Queue", count, static_cast<unsigned>(count));
+    latency_queue<Linked_Queue<int>>("Linked_Queue", count);
+    latency_stack<std::queue<int>>("std::queue", count, "enqueue", "dequeue");
+    latency_stack<Linked_Stack<int>>("Linked_Stack", count);
+    latency_stack<std::stack<int>>("std::stack", count);
+    latency_contended(count);
+}
+
+// Where the nodes of a list sit in memory relative to the list order
+enum class Node_Layout { sequential, shuffled, fragmented };
+
+const char* layout_name(Node_Layout layout) {
+    switch (layout) {
+        case Node_Layout::sequential: return "sequential";
+        case Node_Layout::shuffled: return "shuffled";
+        case Node_Layout::fragmented: return "fragmented";
+    }
+    return "unknown";
+}
+
+// Fills list with 0 .. count-1 in order, with the nodes placed as layout says:
+// sequential  - push_back into a fresh heap, so each node follows the last in memory
+// shuffled    - pushed in random order and radix sorted, which relinks the nodes
+//               without moving them, so list order and address order are unrelated
+// fragmented  - the heap is churned first: 2*count filler nodes are allocated and a
+//               random half freed, and the list reuses those holes, the way a list
+//               does after many inserts and erases. The surviving fillers stay in
+//               filler so the holes stay scattered while the list is measured.
+template <class List>
+void build_layout(List& list, List& filler, size_t count, Node_Layout layout, std::mt19937_64& rng) {
+    if (layout == Node_Layout::sequential) {
+        for (size_t i = 0; i < count; ++i) list.push_back(static_cast<long>(i));
+        return;
+    }
+    std::vector<long> order(layout == Node_Layout::shuffled ? count : 2 * count);
+    for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<long>(i);
+    std::shuffle(order.begin(), order.end(), rng);
+    if (layout == Node_Layout::shuffled) {
+        for (long value : order) list.push_back(value);
+        list.radix_sort();
+        return;
+    }
+    for (long value : order) filler.push_back(value);
+    // Sorting puts the fillers in random address order, so popping frees a random half
+    filler.radix_sort();
+    for (size_t i = 0; i < count; ++i) filler.pop_front();
+    for (size_t i = 0; i < count; ++i) list.push_back(static_cast<long>(i));
+}
+
+// Percentage of nodes whose successor starts at most 64 bytes after them in memory,
+// the pattern hardware prefetchers follow
+template <class List>
+double near_successors(List& list) {
+    uintptr_t previous = 0;
+    size_t near = 0;
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        uintptr_t address = reinterpret_cast<uintptr_t>(&*it);
+        near += previous != 0 && address > previous && address - previous <= 64;
+        previous = address;
+    }
+    return 100.0 * static_cast<double>(near) / static_cast<double>(std::max<size_t>(list.size(), 2) - 1);
+}
+
+// Hands the chunks freed by the previous layout back, so freed nodes do not leave holes that the
+// next sequential list would be built from
+void release_free_memory() {
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
+
+// Traverse, find a missing value and reverse one list type under each layout
+template <class List>
+void bench_list_layout_for(const std::string& name, const std::vector<size_t>& sizes) {
+    std::cout << '\n' << name << "<long> (ns/node)" << std::endl;
+    std::cout << std::left << std::setw(11) << "nodes" << std::setw(12) << "layout" << std::right << std::setw(10)
+              << "near %" << std::setw(11) << "traverse" << std::setw(11) << "find"
+              << std::setw(11) << "reverse" << std::endl;
+    const std::string variant_prefix = name + "/";
+    for (size_t count : sizes) {
+        for (Node_Layout layout : {Node_Layout::sequential, Node_Layout::shuffled, Node_Layout::fragmented}) {
+            release_free_memory();
+            std::mt19937_64 rng(count);
+            List list;
+            List filler;
+            build_layout(list, filler, count, layout, rng);
+            double near = near_successors(list);
+            std::string variant = variant_prefix + layout_name(layout);
+
+            double traverse_ns = time_per_element(count, [&] { do_not_optimize(iterate_sum(list)); });
+            record_result("layout", "traverse", variant, count, traverse_ns, last_counters);
+            double find_ns = time_per_element(count, [&] { do_not_optimize(iterate_find(list, -1)); });
+            record_result("layout", "find", variant, count, find_ns, last_counters);
+            // Reversing twice restores the list, and the nodes never move
+            double reverse_ns = time_per_element(count, [&] { list.reverse(); });
+            record_result("layout", "reverse", variant, count, reverse_ns, last_counters);
+
+            std::cout << std::left << std::setw(11) << count << std::setw(12) << layout_name(layout) << std::right
+                      << std::fixed << std::setprecision(1) << std::setw(10) << near << std::setprecision(2)
+                      << std::setw(11) << traverse_ns << std::setw(11) << find_ns << std::setw(11) << reverse_ns
+                      << std::endl;
+        }
+    }
+}
+
+// Benchmark pointer chasing through the linked lists as node placement and size vary:
+// from a list that fits in L1 up to one far larger than the last-level cache
+void bench_list_layout(size_t max_size) {
+    std::vector<size_t> sizes;
+    for (size_t count : {size_t(1) << 9, size_t(1) << 13, size_t(1) << 17, size_t(1) << 20, size_t(1) << 23}) {
+        if (count <= max_size) sizes.push_back(count);
+    }
+    std::cout << "\nLinked list node layout (512 nodes ~ L1, 8K ~ L2, 128K ~ LLC, 1M and 8M ~ DRAM)" << std::endl;
+    bench_list_layout_for<Single_Linked_List<long>>("Single_Linked_List", sizes);
+    bench_list_layout_for<Doubly_Linked_List<long>>("Doubly_Linked_List", sizes);
+}
+
+// Benchmark SIMD search and reductions over Array<int> storage
+void bench_simd_search(size_t max_size) {
+    std::cout << "\nSIMD search over Array<int> (ns/element)" << std::endl;
+    std::cout << std::left << std::setw(14) << "operation" << std::right << std::setw(12) << "size"
+              << std::setw(12) << "scalar" << std::setw(12) << "simd" << std::setw(10) << "speedup" << std::endl;
+
+    for (size_t size = 1000; size <= max_size; size *= 10) {
+        Array<int> array(size);
+        for (size_t i = 0; i < size; ++i) {
+            array.push_back(static_cast<int>(i % 1000));
+        }
+        const int* data = array.data();
+        const int missing = -1;
+        int needles[] = {-1, -2, -3, -4};
+
+        print_result("find", size,
+            time_per_element(size, [&] { do_not_optimize(simd_detail::find_scalar(data, size, missing)); }),
+            time_per_element(size, [&] { do_not_optimize(simd_find(data, size, missing)); }));
+        print_result("count", size,
+            time_per_element(size, [&] { do_not_optimize(simd_detail::count_scalar(data, size, 7)); }),
+            time_per_element(size, [&] { do_not_optimize(simd_count(data, size, 7)); }));
+        print_result("min", size,
+            time_per_element(size, [&] { do_not_optimize(simd_detail::min_scalar(data, size)); }),
+            time_per_element(size, [&] { do_not_optimize(simd_min(data, size)); }));
+        print_result("max", size,
+            time_per_element(size, [&] { do_not_optimize(simd_detail::max_scalar(data, size)); }),
+            time_per_element(size, [&] { do_not_optimize(simd_max(data, size)); }));
+        print_result("sum", size,
+            time_per_element(size, [&] { do_not_optimize(simd_detail::sum_scalar(data, size)); }),
+            time_per_element(size, [&] { do_not_optimize(simd_sum(data, size)); }));
+        print_result("contains_any", size,
+            time_per_element(size, [&] { do_not_optimize(simd_detail::contains_any_scalar(data, size, needles, 4)); }),
+            time_per_element(size, [&] { do_not_optimize(simd_contains_any(data, size, needles, 4)); }));
+    }
+}
+
+// Benchmark lookups in a sorted array: std::lower_bound, branch-free binary search, Eytzinger
+void bench_sorted_search(size_t max_size) {
+    std::cout << "\nSorted_Array<int> lower_bound (ns/lookup)" << std::endl;
+    std::cout << std::left << std::setw(14) << "size" << std::right << std::setw(14) << "std" << std::setw(14)
+              << "branch-free" << std::setw(14) << "eytzinger" << std::endl;
+
+    const size_t lookups = 1 << 16;
+    std::mt19937 rng(42);
+    for (size_t size = 1000; size <= max_size; size *= 10) {
+        std::vector<int> values(size);
+        for (size_t i = 0; i < size; ++i) {
+            values[i] = static_cast<int>(2 * i);
+        }
+        std::vector<int> queries(lookups);
+        std::uniform_int_distribution<int> pick(0, static_cast<int>(2 * size));
+        for (int& query : queries) {
+            query = pick(rng);
+        }
+
+        Sorted_Array<int> array(values.begin(), values.end());
+        double std_ns = time_per_element(lookups, [&] {
+            size_t total = 0;
+            for (int query : queries) {
+                total += static_cast<size_t>(std::lower_bound(values.begin(), values.end(), query) - values.begin());
+            }
+            do_not_optimize(total);
+        });
+        double plain_ns = time_per_element(lookups, [&] {
+            size_t total = 0;
+            for (int query : queries) {
+                total += array.lower_bound(query);
+            }
+            do_not_optimize(total);
+        });
+        array.build_index();
+        double eytzinger_ns = time_per_element(lookups, [&] {
+            size_t total = 0;
+            for (int query : queries) {
+                total += array.lower_bound(query);
+            }
+            do_not_optimize(total);
+        });
+
+        std::cout << std::left << std::setw(14) << size << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << std_ns << std::setw(14) << plain_ns << std::setw(14) << eytzinger_ns << std::endl;
+    }
+}
+
+// Benchmark scanning a Packed_Array by block decode against an uncompressed Array
+void bench_packed_scan(size_t max_size) {
+    std::cout << "\nPacked_Array<int> sum scan (ns/element)" << std::endl;
+    std::cout << std::left << std::setw(14) << "size" << std::right << std::setw(12) << "ratio" << std::setw(12)
+              << "array" << std::setw(12) << "decode" << std::setw(12) << "at()" << std::endl;
+
+    std::mt19937 rng(7);
+    for (size_t size = 1000; size <= max_size; size *= 10) {
+        Array<int> array(size);
+        for (size_t i = 0; i < size; ++i) {
+            array.push_back(1000000 + static_cast<int>(rng() % 4096));
+        }
+        Packed_Array<int> packed(array);
+        const int* data = array.data();
+
+        double array_ns = time_per_element(size, [&] { do_not_optimize(simd_sum(data, size)); });
+        double decode_ns = time_per_element(size, [&] {
+            int values[Packed_Array<int>::block_size];
+            long long total = 0;
+            for (size_t b = 0; b < packed.block_count(); ++b) {
+                size_t count = packed.decode_block(b, values);
+                total += simd_sum(values, count);
+            }
+            do_not_optimize(total);
+        });
+        double at_ns = time_per_element(size, [&] {
+            long long total = 0;
+            for (size_t i = 0; i < size; ++i) {
+                total += packed.at(i);
+            }
+            do_not_optimize(total);
+        });
+
+        std::cout << std::left << std::setw(14) << size << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << packed.compression_ratio() << std::setprecision(3) << std::setw(12) << array_ns
+                  << std::setw(12) << decode_ns << std::setw(12) << at_ns << std::endl;
+    }
+}
+
+// Benchmark radix_sort against std::sort, copying fresh unsorted input into the work buffer each run
+template <class T, class Sort>
+double time_sort(const std::vector<T>& source, std::vector<T>& work, Sort sort) {
+    return time_per_element(source.size(), [&] {
+        std::copy(source.begin(), source.end(), work.begin());
+        sort(work.data(), work.size());
+        do_not_optimize(work[0]);
+    });
+}
+
+void bench_radix_sort(size_t max_size) {
+    std::cout << "\nradix_sort vs comparison sort (ns/element, including the input copy)" << std::endl;
+    std::cout << std::left << std::setw(14) << "keys" << std::right << std::setw(12) << "size" << std::setw(12)
+              << "std" << std::setw(12) << "radix" << std::setw(10) << "speedup" << std::endl;
+
+    using Record = std::pair<uint64_t, uint32_t>;
+    auto record_key = [](const Record& record) { return record.first; };
+    std::mt19937_64 rng(5);
+    for (size_t size = 1000; size <= std::min<size_t>(max_size, 10000000); size *= 10) {
+        std::vector<int> ints(size), int_work(size);
+        std::vector<uint64_t> wide(size), wide_work(size);
+        std::vector<double> doubles(size), double_work(size);
+        std::vector<Record> records(size), record_work(size);
+        for (size_t i = 0; i < size; ++i) {
+            ints[i] = static_cast<int>(rng());
+            wide[i] = rng();
+            doubles[i] = static_cast<double>(static_cast<int64_t>(rng())) / 1e6;
+            records[i] = {rng() % 100000, static_cast<uint32_t>(i)};
+        }
+
+        print_result("int32", size,
+            time_sort(ints, int_work, [](int* data, size_t n) { std::sort(data, data + n); }),
+            time_sort(ints, int_work, [](int* data, size_t n) { radix_sort(data, n); }));
+        print_result("int32 8-bit", size,
+            time_sort(ints, int_work, [](int* data, size_t n) { std::sort(data, data + n); }),
+            time_sort(ints, int_work, [](int* data, size_t n) { radix_sort<8>(data, n); }));
+        print_result("uint64", size,
+            time_sort(wide, wide_work, [](uint64_t* data, size_t n) { std::sort(data, data + n); }),
+            time_sort(wide, wide_work, [](uint64_t* data, size_t n) { radix_sort(data, n); }));
+        print_result("double", size,
+            time_sort(doubles, double_work, [](double* data, size_t n) { std::sort(data, data + n); }),
+            time_sort(doubles, double_work, [](double* data, size_t n) { radix_sort(data, n); }));
+        print_result("record key", size,
+            time_sort(records, record_work, [&](Record* data, size_t n) {
+                std::stable_sort(data, data + n, [&](const Record& a, const Record& b) {
+                    return record_key(a) < record_key(b);
+                });
+            }),
+            time_sort(records, record_work, [&](Record* data, size_t n) { radix_sort(data, n, record_key); }));
+    }
+}
+
+// Benchmark infix_to_postfix: the cost per token should stay flat as expressions grow
+void bench_infix_to_postfix(size_t max_size) {
+    std::cout << "\ninfix_to_postfix (ns/token)" << std::endl;
+    std::cout << std::left << std::setw(14) << "tokens" << std::right << std::setw(14) << "string" << std::setw(14)
+              << "buffer" << std::endl;
+
+    std::mt19937 rng(9);
+    const char operators[] = "+-*/";
+    for (size_t tokens = 10; tokens <= std::min<size_t>(max_size, 1000000); tokens *= 10) {
+        std::string expression = std::to_string(rng() % 1000);
+        while (expression.size() < 4 * tokens) {
+            expression += ' ';
+            expression += operators[rng() % 4];
+            expression += rng() % 4 == 0 ? " (" : " ";
+            expression += std::to_string(rng() % 1000);
+        }
+        size_t open = static_cast<size_t>(std::count(expression.begin(), expression.end(), '('));
+        expression.append(open, ')');
+        std::vector<char> buffer(2 * expression.size());
+
+        double string_ns = time_per_element(tokens, [&] { do_not_optimize(infix_to_postfix(expression).size()); });
+        double buffer_ns = time_per_element(tokens, [&] {
+            do_not_optimize(infix_to_postfix(std::string_view(expression), buffer.data()));
+        });
+
+        std::cout << std::left << std::setw(14) << tokens << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << string_ns << std::setw(14) << buffer_ns << std::endl;
+    }
+}
+
+// Benchmark Calc: compiling on every call against evaluating a program compiled once
+void bench_calc_program() {
+    std::cout << "\nCalc expression evaluation (ns/expression)" << std::endl;
+    std::cout << std::left << std::setw(14) << "operators" << std::right << std::setw(14) << "compile+eval" << std::setw(14) << "evaluate" << std::endl;
+
+    std::mt19937 rng(3);
+    const char operators[] = "+-*/";
+    for (size_t count : {4, 16, 64}) {
+        std::string expression = std::to_string(rng() % 9 + 1);
+        for (size_t i = 0; i < count; ++i) {
+            expression += ' ';
+            expression += operators[rng() % 4];
+            expression += ' ';
+            expression += std::to_string(rng() % 9 + 1);
+        }
+        Calc_Program<long> program = compile(expression);
+
+        double compile_ns = time_per_element(1, [&] { do_not_optimize(evaluate(compile(expression))); });
+        double evaluate_ns = time_per_element(1, [&] { do_not_optimize(evaluate(program)); });
+
+        std::cout << std::left << std::setw(14) << count << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << compile_ns << std::setw(14) << evaluate_ns
+                  << std::endl;
+    }
+}
+
+// Builds an expression of multi-digit numbers; decimals adds a fraction to each.
+// Each product is divided straight away, so integer results stay far from overflow.
+std::string number_expression(size_t count, bool decimals) {
+    std::mt19937 rng(11);
+    const char operators[] = "+*/-";
+    std::string expression;
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) {
+            expression += ' ';
+            expression += operators[i % 4];
+            expression += ' ';
+        }
+        expression += std::to_string(rng() % 900000 + 100000);
+        if (decimals) expression += '.' + std::to_string(rng() % 1000);
+    }
+    return expression;
+}
+
+// Benchmark number parsing and checked arithmetic: compile+evaluate and postfix evaluation per number
+template <class Num>
+void bench_calc_numbers_for(const std::string& name, bool decimals) {
+    const size_t count = 64;
+    std::string expression = number_expression(count, decimals);
+    std::string postfix = infix_to_postfix(expression);
+    Calc_Program<Num> program;
+    std::vector<char> operators;
+    double compile_ns = time_per_element(count, [&] {
+        Num result{};
+        calc_compile(expression, program, operators);
+        calc_evaluate(program, result);
+        do_not_optimize(result);
+    });
+    double postfix_ns = time_per_element(count, [&] {
+        do_not_optimize(expression_evaluation<Num>(postfix));
+    });
+    std::cout << std::left << std::setw(14) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(16) << compile_ns << std::setw(16) << postfix_ns << std::endl;
+}
+
+void bench_calc_numbers() {
+    std::cout << "\nCalc number parsing with checked arithmetic (ns/number)" << std::endl;
+    std::cout << std::left << std::setw(14) << "type" << std::right << std::setw(16) << "compile+eval" << std::setw(16)
+              << "postfix eval" << std::endl;
+    bench_calc_numbers_for<long>("long", false);
+    bench_calc_numbers_for<double>("double", true);
+#ifdef __SIZEOF_INT128__
+    bench_calc_numbers_for<calc_int128>("int128", false);
+#endif
+}
+
+// Benchmark end-to-end throughput of the postfix path: infix_to_postfix then expression_evaluation
+void bench_calc_throughput(size_t max_size) {
+    std::cout << "\nPostfix Calc throughput (ns/number)" << std::endl;
+    std::cout << std::left << std::setw(14) << "numbers" << std::right << std::setw(16) << "infix_to_postfix"
+              << std::setw(16) << "evaluation" << std::setw(16) << "MB/s" << std::endl;
+    for (size_t count = 10; count <= std::min<size_t>(max_size, 1000000); count *= 10) {
+        std::string expression = number_expression(count, false);
+        std::string postfix = infix_to_postfix(expression);
+        double convert_ns = time_per_element(count, [&] { do_not_optimize(infix_to_postfix(expression).size()); });
+        record_result("calc", "infix_to_postfix", "long", count, convert_ns, last_counters);
+        double evaluate_ns = time_per_element(count, [&] { do_not_optimize(expression_evaluation<long>(postfix)); });
+        record_result("calc", "expression_evaluation", "long", count, evaluate_ns, last_counters);
+        double bytes_per_number = static_cast<double>(expression.size()) / static_cast<double>(count);
+        std::cout << std::left << std::setw(14) << count << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(16) << convert_ns << std::setw(16) << evaluate_ns << std::setprecision(1)
+                  << std::setw(16) << 1000.0 * bytes_per_number / (convert_ns + evaluate_ns) << std::endl;
+    }
+}
+
+// Benchmark a formula over columns: per-row bytecode dispatch against block-at-a-time columnar evaluation
+template <class Num>
+void bench_calc_columns_for(const std::string& name, size_t rows) {
+    Calc_Program<Num> program = compile<Num>("(a + b) * c - a / 4 + 3");
+    std::vector<Num> a(rows), b(rows), c(rows), out(rows);
+    std::mt19937 rng(17);
+    for (size_t i = 0; i < rows; ++i) {
+        a[i] = static_cast<Num>(rng() % 1000);
+        b[i] = static_cast<Num>(rng() % 1000);
+        c[i] = static_cast<Num>(rng() % 100 + 1);
+    }
+    std::vector<const Num*> columns = bind_columns(program, {{"a", a.data()}, {"b", b.data()}, {"c", c.data()}});
+
+    print_result(name, rows,
+        time_per_element(rows, [&] {
+            for (size_t i = 0; i < rows; ++i) {
+                Num row[] = {a[i], b[i], c[i]};
+                calc_evaluate(program, out[i], row);
+            }
+            do_not_optimize(out[0]);
+        }),
+        time_per_element(rows, [&] {
+            calc_evaluate_columns(program, columns.data(), rows, out.data());
+            do_not_optimize(out[0]);
+        }));
+}
+
+void bench_calc_columns(size_t max_size) {
+    std::cout << "\nCalc formula over columns (ns/row)" << std::endl;
+    std::cout << std::left << std::setw(14) << "type" << std::right << std::setw(12) << "rows" << std::setw(12)
+              << "per-row" << std::setw(12) << "columnar" << std::setw(10) << "speedup" << std::endl;
+    for (size_t rows = 1000; rows <= std::min<size_t>(max_size, 10000000); rows *= 10) {
+        bench_calc_columns_for<long>("long", rows);
+        bench_calc_columns_for<double>("double", rows);
+    }
+}
+
+// Benchmark repeated formulas: compiling every time against the LRU caches
+void bench_calc_cache() {
+    std::cout << "\nRepeated Calc formulas (ns/evaluation)" << std::endl;
+    std::cout << std::left << std::setw(14) << "formulas" << std::right << std::setw(14) << "compile" << std::setw(14)
+              << "lru" << std::setw(14) << "sharded" << std::setw(12) << "hit rate" << std::endl;
+
+    std::mt19937 rng(21);
+    const char operators[] = "+-*/";
+    for (size_t distinct : {100, 1000, 10000}) {
+        std::vector<std::string> formulas(distinct);
+        for (std::string& formula : formulas) {
+            formula = std::to_string(rng() % 1000 + 1);
+            for (int i = 0; i < 6; ++i) {
+                formula += ' ';
+                formula += operators[rng() % 4];
+                formula += ' ';
+                formula += std::to_string(rng() % 1000 + 1);
+            }
+        }
+        // Skewed traffic: most requests go to a few formulas
+        std::vector<std::string_view> requests(1 << 16);
+        for (std::string_view& request : requests) {
+            size_t pick = static_cast<size_t>(std::pow(static_cast<double>(rng() % 1000000) / 1e6, 3.0) * distinct);
+            request = formulas[pick];
+        }
+
+        Calc_Cache<long> cache(1024);
+        Sharded_Calc_Cache<long> sharded(1024);
+        double compile_ns = time_per_element(requests.size(), [&] {
+            long total = 0;
+            for (std::string_view request : requests) total += evaluate(compile(request));
+            do_not_optimize(total);
+        });
+        double lru_ns = time_per_element(requests.size(), [&] {
+            long total = 0;
+            for (std::string_view request : requests) total += cache.evaluate(request);
+            do_not_optimize(total);
+        });
+        double sharded_ns = time_per_element(requests.size(), [&] {
+            long total = 0;
+            for (std::string_view request : requests) total += sharded.evaluate(request);
+            do_not_optimize(total);
+        });
+        Calc_Cache_Stats stats = cache.stats();
+
+        std::cout << std::left << std::setw(14) << distinct << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << compile_ns << std::setw(14) << lru_ns << std::setw(14) << sharded_ns
+                  << std::setprecision(3) << std::setw(12)
+                  << static_cast<double>(stats.hits) / static_cast<double>(stats.hits + stats.misses) << std::endl;
+    }
+}
+
+// Builds a formula the way generators tend to: repeated subterms, constant factors and neutral elements
+std::string generated_formula(std::mt19937& rng, int depth) {
+    if (depth == 0) {
+        const char* leaves[] = {"a", "b", "c", "2", "3", "(4 * 5 - 19)", "(a + b)", "(b * c)"};
+        return leaves[rng() % 8];
+    }
+    const char operators[] = "+-*";
+    std::string left = generated_formula(rng, depth - 1);
+    std::string right = rng() % 3 == 0 ? left : generated_formula(rng, depth - 1);
+    std::string formula = "(" + left + ' ' + operators[rng() % 3] + ' ' + right + ")";
+    switch (rng() % 4) {
+        case 0: return formula + " * 1";
+        case 1: return formula + " + (6 - 2 * 3)";
+        default: return formula;
+    }
+}
+
+// Benchmark the optimizer on a generated corpus: node counts, then evaluation before and after
+void bench_calc_optimizer(size_t max_size) {
+    std::mt19937 rng(29);
+    size_t rows = std::min<size_t>(max_size, 100000);
+    std::vector<long> a(rows), b(rows), c(rows), out(rows);
+    for (size_t i = 0; i < rows; ++i) {
+        a[i] = static_cast<long>(rng() % 100);
+        b[i] = static_cast<long>(rng() % 100);
+        c[i] = static_cast<long>(rng() % 100);
+    }
+
+    std::vector<Calc_Program<long>> originals;
+    std::vector<Calc_Program<long>> optimized;
+    Calc_Optimize_Stats total;
+    for (int i = 0; i < 50; ++i) {
+        originals.push_back(compile(generated_formula(rng, 6)));
+        Calc_Optimize_Stats stats;
+        optimized.push_back(optimize(originals.back(), &stats));
+        total.nodes_before += stats.nodes_before;
+        total.nodes_after += stats.nodes_after;
+        total.folded += stats.folded;
+        total.identities += stats.identities;
+        total.shared += stats.shared;
+    }
+    std::cout << "\nCalc optimizer on 50 generated formulas: " << total.nodes_before << " nodes before, "
+              << total.nodes_after << " after (" << total.folded << " folded, " << total.identities
+              << " identities, " << total.shared << " shared)" << std::endl;
+    std::cout << std::left << std::setw(14) << "evaluation" << std::right << std::setw(12) << "rows" << std::setw(12)
+              << "original" << std::setw(12) << "optimized" << std::setw(10) << "speedup" << std::endl;
+
+    auto per_row = [&](const std::vector<Calc_Program<long>>& programs) {
+        return time_per_element(rows * programs.size(), [&] {
+            long sum = 0;
+            for (const Calc_Program<long>& program : programs) {
+                for (size_t i = 0; i < rows; ++i) {
+                    long values[3] = {a[i], b[i], c[i]};
+                    long value = 0;
+                    calc_evaluate(program, value, values);
+                    sum += value;
+                }
+            }
+            do_not_optimize(sum);
+        });
+    };
+    auto columnar = [&](const std::vector<Calc_Program<long>>& programs) {
+        return time_per_element(rows * programs.size(), [&] {
+            for (const Calc_Program<long>& program : programs) {
+                std::vector<const long*> columns;
+                for (const std::string& name : program.variables()) {
+                    columns.push_back(name == "a" ? a.data() : name == "b" ? b.data() : c.data());
+                }
+                calc_evaluate_columns(program, columns.data(), rows, out.data());
+                do_not_optimize(out[0]);
+            }
+        });
+    };
+    print_result("per-row", rows, per_row(originals), per_row(optimized));
+    print_result("columnar", rows, columnar(originals), columnar(optimized));
+}
+
+// Benchmark a sheet of dependent formulas: full recalculation against recalculating one cell's cone
+void bench_calc_sheet(size_t max_size) {
+    std::cout << "\nCalc sheet recalculation (us/recalculation)" << std::endl;
+    std::cout << std::left << std::setw(14) << "formulas" << std::right << std::setw(14) << "full" << std::setw(14)
+              << "full pool" << std::setw(14) << "one change" << std::setw(12) << "cone" << std::endl;
+
+    const size_t rows = 10;
+    for (size_t width = 100; width * rows <= std::min<size_t>(max_size, 1000000); width *= 10) {
+        // Each cell adds two neighbours from the row above, so a change spreads one column per row
+        Calc_Sheet<long> sheet;
+        auto cell = [](size_t row, size_t column) { return "r" + std::to_string(row) + "c" + std::to_string(column); };
+        for (size_t column = 0; column < width; ++column) {
+            sheet.set_value(cell(0, column), static_cast<long>(column % 100));
+        }
+        for (size_t row = 1; row <= rows; ++row) {
+            for (size_t column = 0; column < width; ++column) {
+                sheet.set_formula(cell(row, column),
+                                  cell(row - 1, column) + " + " + cell(row - 1, (column + 1) % width) + " / 2");
+            }
+        }
+        sheet.recalculate();
+        std::string changed = cell(0, width / 2);
+
+        double full_us = time_per_element(1, [&] {
+            sheet.mark_all_dirty();
+            do_not_optimize(sheet.recalculate());
+        }) / 1000.0;
+        double pool_us = time_per_element(1, [&] {
+            sheet.mark_all_dirty();
+            do_not_optimize(sheet.recalculate(Thread_Pool::shared()));
+        }) / 1000.0;
+        long next = 0;
+        size_t cone = 0;
+        double change_us = time_per_element(1, [&] {
+            sheet.set_value(changed, ++next % 100);
+            cone = sheet.recalculate();
+        }) / 1000.0;
+
+        std::cout << std::left << std::setw(14) << width * rows << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << full_us << std::setw(14) << pool_us << std::setw(14) << change_us
+                  << std::setw(12) << cone << std::endl;
+    }
+}
+
+// Times one call of op in milliseconds
+template <class Op>
+double time_once_ms(Op op) {
+    auto start = std::chrono::steady_clock::now();
+    op();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Benchmark batched Calc evaluation throughput from one worker to every hardware thread
+void bench_calc_batch(size_t max_size) {
+    size_t count = std::min<size_t>(max_size, 1000000);
+    size_t hardware = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    std::cout << "\nevaluate_batch over " << count << " expressions" << std::endl;
+    std::cout << std::left << std::setw(10) << "threads" << std::right << std::setw(16) << "ms" << std::setw(20)
+              << "expressions/s" << std::endl;
+
+    std::mt19937 rng(13);
+    const char operators[] = "+-*/";
+    std::vector<std::string> texts(count);
+    for (std::string& text : texts) {
+        text = std::to_string(rng() % 1000 + 1);
+        for (int i = 0; i < 8; ++i) {
+            text += ' ';
+            text += operators[rng() % 4];
+            text += ' ';
+            text += std::to_string(rng() % 1000 + 1);
+        }
+    }
+    std::vector<std::string_view> expressions(texts.begin(), texts.end());
+    std::vector<long> results(count);
+    std::vector<Calc_Status> statuses(count);
+
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < hardware; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(hardware);
+
+    for (size_t threads : thread_counts) {
+        Thread_Pool pool(threads);
+        evaluate_batch(pool, expressions.data(), count, results.data(), statuses.data());
+        double ms = time_once_ms([&] {
+            do_not_optimize(evaluate_batch(pool, expressions.data(), count, results.data(), statuses.data()));
+        });
+        std::cout << std::left << std::setw(10) << threads << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(16) << ms << std::setprecision(0) << std::setw(20)
+                  << static_cast<double>(count) / (ms / 1000.0) << std::endl;
+    }
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// Benchmark evaluating a file of expressions: getline into std::string against the mapped streaming front end
+void bench_calc_stream(size_t max_size) {
+    size_t lines = std::min<size_t>(max_size, 2000000);
+    const std::string input_path = "calc_stream_bench_input.txt";
+    const std::string output_path = "calc_stream_bench_output.txt";
+    std::mt19937 rng(23);
+    const char operators[] = "+-*/";
+    size_t bytes = 0;
+    {
+        Output_Sink writer(input_path);
+        for (size_t i = 0; i < lines; ++i) {
+            std::string line = std::to_string(rng() % 1000 + 1);
+            for (int j = 0; j < 6; ++j) {
+                line += ' ';
+                line += operators[rng() % 4];
+                line += ' ';
+                line += std::to_string(rng() % 1000 + 1);
+            }
+            line += '\n';
+            bytes += line.size();
+            writer.write(line);
+        }
+    }
+    std::cout << "\nCalc over a file of " << lines << " lines (" << bytes / 1000000 << " MB)" << std::endl;
+    std::cout << std::left << std::setw(24) << "front end" << std::right << std::setw(12) << "ms" << std::setw(12)
+              << "MB/s" << std::endl;
+    auto report = [&](const std::string& name, double ms) {
+        std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << ms << std::setw(12) << static_cast<double>(bytes) / 1000.0 / ms << std::endl;
+    };
+
+    report("getline + ofstream", time_once_ms([&] {
+        std::ifstream in(input_path);
+        std::ofstream out(output_path);
+        std::string line;
+        while (std::getline(in, line)) {
+            long value = 0;
+            Calc_Status status = calc_evaluate(compile(line), value);
+            if (status == Calc_Status::ok) {
+                out << value << '\n';
+            } else {
+                out << "error: " << calc_status_message(status) << '\n';
+            }
+        }
+    }));
+    report("evaluate_file", time_once_ms([&] { evaluate_file(input_path, output_path); }));
+    Thread_Pool pool;
+    report("evaluate_file parallel", time_once_ms([&] { evaluate_file(pool, input_path, output_path); }));
+
+    std::remove(input_path.c_str());
+    std::remove(output_path.c_str());
+}
+#endif
+
+// Benchmark parallel_sort and parallel_reduce scaling from one worker to every hardware thread
+void bench_parallel_scaling(size_t max_size) {
+    size_t size = std::min<size_t>(max_size, 10000000);
+    size_t hardware = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    std::cout << "\nParallel scaling over Array<int> of " << size << " elements (ms)" << std::endl;
+    std::cout << std::left << std::setw(10) << "threads" << std::right << std::setw(14) << "std::sort"
+              << std::setw(16) << "parallel_sort" << std::setw(10) << "speedup" << std::setw(18) << "parallel_reduce"
+              << std::endl;
+
+    std::mt19937 rng(11);
+    std::vector<int> source(size);
+    for (int& value : source) {
+        value = static_cast<int>(rng());
+    }
+    std::vector<int> work(size);
+    std::copy(source.begin(), source.end(), work.begin());
+    double std_ms = time_once_ms([&] { std::sort(work.begin(), work.end()); });
+
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < hardware; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(hardware);
+
+    for (size_t threads : thread_counts) {
+        Thread_Pool pool(threads);
+        std::copy(source.begin(), source.end(), work.begin());
+        double sort_ms = time_once_ms([&] { parallel_sort(pool, work.data(), size); });
+        double reduce_ms = time_once_ms([&] {
+            do_not_optimize(parallel_reduce(pool, work.data(), size, 0LL,
+                                            [](long long total, int value) { return total + value; }));
+        });
+        std::cout << std::left << std::setw(10) << threads << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << std_ms << std::setw(16) << sort_ms << std::setprecision(2) << std::setw(9)
+                  << std_ms / sort_ms << 'x' << std::setprecision(1) << std::setw(18) << reduce_ms << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t max_size = 100000000;
+    std::string json_path;
+    std::string only;
+    bool counters = true;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--no-counters") {
+            counters = false;
+        } else if (argument == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (argument == "--only" && i + 1 < argc) {
+            only = argv[++i];
+        } else if (!argument.empty() && argument[0] != '-') {
+            max_size = std::strtoull(argument.c_str(), nullptr, 10);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [max_size] [--only suite] [--json file] [--no-counters]" << std::endl;
+            return 1;
+        }
+    }
+
+    const std::vector<std::pair<std::string, std::function<void()>>> suites = {
+        {"containers", [&] { bench_containers(max_size); }},
+        {"layout", [&] { bench_list_layout(max_size); }},
+        {"latency", [&] { bench_latency(max_size); }},
+        {"simd_search", [&] { bench_simd_search(max_size); }},
+        {"sorted_search", [&] { bench_sorted_search(max_size); }},
+        {"packed_scan", [&] { bench_packed_scan(max_size); }},
+        {"parallel", [&] { bench_parallel_scaling(max_size); }},
+        {"radix_sort", [&] { bench_radix_sort(max_size); }},
+        {"infix_to_postfix", [&] { bench_infix_to_postfix(max_size); }},
+        {"calc", [&] {
+            bench_calc_throughput(max_size);
+            bench_calc_program();
+            bench_calc_numbers();
+        }},
+        {"calc_batch", [&] { bench_calc_batch(max_size); }},
+        {"calc_columns", [&] { bench_calc_columns(max_size); }},
+        {"calc_cache", [&] { bench_calc_cache(); }},
+        {"calc_optimizer", [&] { bench_calc_optimizer(max_size); }},
+        {"calc_sheet", [&] { bench_calc_sheet(max_size); }},
+#if defined(__unix__) || defined(__APPLE__)
+        {"calc_stream", [&] { bench_calc_stream(max_size); }},
+#endif
+    };
+
+    if (!only.empty() && std::none_of(suites.begin(), suites.end(), [&](const auto& suite) { return suite.first == only; })) {
+        std::cerr << "No benchmark suite named " << only << std::endl;
+        return 1;
+    }
+
+    std::cout << "Starting Data Structures Benchmarks..." << std::endl;
+
+    Perf_Counters perf;
+    if (counters && perf.any_available()) {
+        bench_counters = &perf;
+        std::cout << "Hardware counters per element:";
+        for (size_t event = 0; event < perf_event_count; ++event) {
+            if (perf.available(static_cast<Perf_Event>(event))) {
+                std::cout << ' ' << perf_event_name(static_cast<Perf_Event>(event));
+            }
+        }
+        std::cout << std::endl;
+    } else if (counters) {
+        std::cout << "Hardware counters unavailable (no PMU access through perf_event_open); timings only" << std::endl;
+    }
+
+    for (const auto& suite : suites) {
+        if (only.empty() || only == suite.first) {
+            suite.second();
+        }
+    }
+
+    if (!json_path.empty() && !write_json(json_path)) {
+        std::cerr << "Cannot write " << json_path << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nAll benchmarks completed!" << std::endl;
+    return 0;
+}
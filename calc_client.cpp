@@ -0,0 +1,119 @@
+// Load generator for calc_server.
+//
+// Usage: calc_client <socket path> [connections] [seconds] [batch size] [distinct formulas]
+// Each connection sends batches back to back; the report gives throughput and
+// the round-trip latency distribution of a batch. Each connection records into
+// its own Latency_Histogram, and they are merged for the report.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Calc_Protocol.h"
+#include "Latency_Histogram.h"
+
+namespace {
+
+std::vector<std::string> make_formulas(size_t count) {
+    std::mt19937 rng(5);
+    const char operators[] = "+-*/";
+    std::vector<std::string> formulas(count);
+    for (std::string& formula : formulas) {
+        formula = std::to_string(rng() % 1000 + 1);
+        for (int i = 0; i < 6; ++i) {
+            formula += ' ';
+            formula += operators[rng() % 4];
+            formula += rng() % 3 == 0 ? " (" + std::to_string(rng() % 100 + 1) + " + 1)" : " " + std::to_string(rng() % 1000 + 1);
+        }
+    }
+    return formulas;
+}
+
+double microseconds(uint64_t nanoseconds) {
+    return static_cast<double>(nanoseconds) / 1000.0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <socket path> [connections] [seconds] [batch size] [distinct formulas]"
+                  << std::endl;
+        return 2;
+    }
+    const std::string path = argv[1];
+    const size_t connections = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 4;
+    const double seconds = argc > 3 ? std::strtod(argv[3], nullptr) : 5.0;
+    const size_t batch = std::max<size_t>(argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 64, 1);
+    const size_t distinct = std::max<size_t>(argc > 5 ? std::strtoul(argv[5], nullptr, 10) : 1000, 1);
+
+    const std::vector<std::string> formulas = make_formulas(distinct);
+    std::vector<Latency_Histogram> latencies(connections);
+    std::vector<size_t> failures(connections, 0);
+    std::vector<std::string> errors(connections);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (size_t c = 0; c < connections; ++c) {
+        threads.emplace_back([&, c] {
+            try {
+                Calc_Client<long> client(path);
+                std::mt19937 rng(static_cast<unsigned>(c));
+                std::vector<std::string_view> requests(batch);
+                std::vector<long> values;
+                std::vector<Calc_Status> statuses;
+                while (std::chrono::steady_clock::now() < deadline) {
+                    for (std::string_view& request : requests) request = formulas[rng() % formulas.size()];
+                    auto sent = std::chrono::steady_clock::now();
+                    client.evaluate(requests.data(), requests.size(), values, statuses);
+                    latencies[c].record_since(sent);
+                    failures[c] += static_cast<size_t>(
+                        std::count_if(statuses.begin(), statuses.end(),
+                                      [](Calc_Status status) { return status != Calc_Status::ok; }));
+                }
+            } catch (const std::exception& error) {
+                errors[c] = error.what();
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    Latency_Histogram all;
+    size_t failed = 0;
+    for (size_t c = 0; c < connections; ++c) {
+        if (!errors[c].empty()) {
+            std::cerr << "connection " << c << ": " << errors[c] << std::endl;
+        }
+        all.merge(latencies[c]);
+        failed += failures[c];
+    }
+    if (all.count() == 0) {
+        std::cerr << "no batches completed" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(0);
+    std::cout << connections << " connections, batches of " << batch << ", " << distinct << " distinct formulas"
+              << std::endl;
+    std::cout << "batches/s      " << static_cast<double>(all.count()) / elapsed << std::endl;
+    std::cout << "expressions/s  " << static_cast<double>(all.count() * batch) / elapsed << " (" << failed
+              << " failed)" << std::endl;
+    std::cout << std::setprecision(1);
+    std::cout << "latency us     p50 " << microseconds(all.percentile(50)) << "  p99 "
+              << microseconds(all.percentile(99)) << "  p99.9 " << microseconds(all.percentile(99.9)) << "  max "
+              << microseconds(all.max()) << std::endl;
+    return 0;
+}
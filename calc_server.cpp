@@ -0,0 +1,62 @@
+// Local Calc evaluation daemon.
+//
+// Usage: calc_server <socket path> [threads] [cache capacity]
+// Runs until SIGINT or SIGTERM, then prints what it served.
+
+#include <csignal>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "Calc_Server.h"
+
+namespace {
+
+Calc_Server<long>* running_server = nullptr;
+
+extern "C" void stop_server(int) {
+    if (running_server != nullptr) {
+        running_server->stop();
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <socket path> [threads] [cache capacity]" << std::endl;
+        return 2;
+    }
+    try {
+        size_t threads = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1;
+        size_t capacity = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 16384;
+        Calc_Server<long> server(argv[1], threads, capacity);
+
+        running_server = &server;
+        struct sigaction action {};
+        action.sa_handler = stop_server;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+        std::signal(SIGPIPE, SIG_IGN);
+
+        std::cout << "Listening on " << argv[1] << " with " << threads << " thread(s)" << std::endl;
+        server.run();
+        running_server = nullptr;
+
+        Calc_Server_Stats stats = server.stats();
+        Calc_Cache_Stats cache = server.cache_stats();
+        std::cout << stats.connections << " connections, " << stats.batches << " batches, " << stats.expressions
+                  << " expressions (" << stats.errors << " failed), cache hits " << cache.hits << " misses "
+                  << cache.misses << std::endl;
+        if (stats.accept_failures != 0) {
+            std::cout << stats.accept_failures << " times out of descriptors or memory while accepting"
+                      << std::endl;
+        }
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
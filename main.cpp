@@ -10,10 +10,8 @@ int main () {
     l.push_back(4);
     l.push_back(5);
 
-    Doubly_Linked_List<int>::iterator it = l.begin();
-
-    for (auto i =l.begin(); i != l.end(); ++i) {
-        cout << *i << endl;
+    for (Doubly_Linked_List<int>::Iterator it = l.begin(); it != l.end(); ++it) {
+        cout << *it << endl;
     }
 
     return 0;
@@ -1,6 +1,11 @@
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
+#include <limits>
 #include <string>
+#include <thread>
 #include "Doubly_Linked_List.h"
 #include "Linked_List.h"
 #include "Array_Queue.h"
@@ -8,10 +13,40 @@
 #include "Linked_Stack.h"
 #include "Array_Stack.h"
 #include "Linked_List_Array.h"
+#include "Memory_Stats.h"
+#include "Perf_Counters.h"
+#include "Latency_Histogram.h"
+#include "Gap_Buffer.h"
+#include "Simd_Search.h"
+#include "Small_Array.h"
+#include "Mapped_Array.h"
+#include "Sorted_Array.h"
+#include "SoA_Array.h"
+#include "Packed_Array.h"
+#include "Parallel.h"
+#include "Radix_Sort.h"
+#include "Calc.h"
+#include "Calc_Program.h"
+#include "Calc_Batch.h"
+#include "Calc_Columns.h"
+#include "Calc_Cache.h"
+#include "Calc_Optimizer.h"
+#include "Calc_Sheet.h"
+#include "Calc_Stream.h"
+#include "Calc_Protocol.h"
+#include "Calc_Server.h"
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#endif
+
+// Number of failed checks, which becomes the exit status so ctest sees failures
+int failed_tests = 0;
 
 // Helper function to print test results
 void print_test_result(const std::string& test_name, bool passed) {
     std::cout << test_name << ": " << (passed ? "PASSED" : "FAILED") << std::endl;
+    failed_tests += !passed;
 }
 
 // Test Doubly Linked List
@@ -63,6 +98,24 @@ void test_doubly_linked_list() {
     passed = list.size() == 2;
     print_test_result("Reverse", passed);
 
+    // Reversing must move both ends, so appending afterwards lands at the new back
+    Doubly_Linked_List<int> ends;
+    for (int i = 1; i <= 4; ++i) {
+        ends.push_back(i);
+    }
+    ends.reverse();
+    ends.push_back(0);
+    ends.reverse();
+    ends.reverse();
+    int expected_end[] = {4, 3, 2, 1, 0};
+    passed = ends.size() == 5;
+    size_t position = 0;
+    for (int value : ends) {
+        passed &= position < 5 && value == expected_end[position++];
+    }
+    passed &= position == 5;
+    print_test_result("Reverse keeps both ends", passed);
+
     // Test move semantics
     Doubly_Linked_List<int> list2 = std::move(list);
     passed = list2.size() == 2 && list.empty();
@@ -148,12 +201,13 @@ void test_array_queue() {
     print_test_result("Enqueue", passed);
 
     // Test dequeue
-    int value = queue.dequeue();
+    int value = 0;
+    queue.dequeue(value);
     passed = value == 1;
     print_test_result("Dequeue", passed);
 
     // Test front
-    value = queue.front();
+    value = queue.get_front();
     passed = value == 2;
     print_test_result("Front", passed);
 
@@ -161,7 +215,7 @@ void test_array_queue() {
     queue.enqueue(4);
     queue.enqueue(5);
     queue.enqueue(6);
-    passed = queue.full();
+    passed = queue.isfull();
     print_test_result("Full queue", passed);
 }
 
@@ -184,12 +238,13 @@ void test_linked_queue() {
     print_test_result("Enqueue", passed);
 
     // Test dequeue
-    int value = queue.dequeue();
+    int value = 0;
+    queue.dequeue(value);
     passed = value == 1;
     print_test_result("Dequeue", passed);
 
     // Test front
-    value = queue.front();
+    value = queue.get_front();
     passed = value == 2;
     print_test_result("Front", passed);
 
@@ -218,12 +273,13 @@ void test_linked_stack() {
     print_test_result("Push", passed);
 
     // Test pop
-    int value = stack.pop();
+    int value = 0;
+    stack.pop(value);
     passed = value == 3;
     print_test_result("Pop", passed);
 
     // Test top
-    value = stack.top();
+    value = stack.get_top();
     passed = value == 2;
     print_test_result("Top", passed);
 
@@ -252,12 +308,13 @@ void test_array_stack() {
     print_test_result("Push", passed);
 
     // Test pop
-    int value = stack.pop();
+    int value = 0;
+    stack.pop(value);
     passed = value == 3;
     print_test_result("Pop", passed);
 
     // Test top
-    value = stack.top();
+    value = stack.get_top();
     passed = value == 2;
     print_test_result("Top", passed);
 
@@ -265,7 +322,7 @@ void test_array_stack() {
     stack.push(4);
     stack.push(5);
     stack.push(6);
-    passed = stack.full();
+    passed = stack.isfull();
     print_test_result("Full stack", passed);
 }
 
@@ -273,7 +330,7 @@ void test_array_stack() {
 void test_linked_list_array() {
     std::cout << "\nTesting Linked List Array:" << std::endl;
     
-    Linked_List_Array<int> array(5);
+    Array<int> array(5);
     bool passed = true;
 
     // Test empty array
@@ -289,17 +346,17 @@ void test_linked_list_array() {
 
     // Test push_front
     array.push_front(0);
-    passed = array.size() == 4;
+    passed = array.get_length() == 4;
     print_test_result("Push front", passed);
 
     // Test insert
     array.insert(2, 5);
-    passed = array.size() == 5;
+    passed = array.get_length() == 5;
     print_test_result("Insert", passed);
 
     // Test erase
     array.erase(1);
-    passed = array.size() == 4;
+    passed = array.get_length() == 4;
     print_test_result("Erase", passed);
 
     // Test full array
@@ -308,6 +365,1189 @@ void test_linked_list_array() {
     print_test_result("Full array", passed);
 }
 
+// Test Array range insert/erase
+void test_array_ranges() {
+    std::cout << "\nTesting Array Ranges:" << std::endl;
+
+    Array<int> array(10);
+    bool passed = true;
+
+    // Test range insert into the middle
+    int values[] = {1, 2, 3, 4};
+    array.push_back(0);
+    array.push_back(5);
+    array.insert(1, values, values + 4);
+    passed = array.get_length() == 6;
+    for (size_t i = 0; i < array.get_length(); ++i) {
+        passed &= array.at(i) == static_cast<int>(i);
+    }
+    print_test_result("Range insert", passed);
+
+    // Test push_front shift
+    array.push_front(-1);
+    passed = array.get_length() == 7 && array.at(0) == -1 && array.at(6) == 5;
+    print_test_result("Push front", passed);
+
+    // Test range erase
+    array.erase(1, 4);
+    passed = array.get_length() == 4 && array.at(0) == -1 && array.at(1) == 3 && array.at(3) == 5;
+    print_test_result("Range erase", passed);
+
+    // Test non-trivially copyable elements
+    Array<std::string> words(5);
+    std::string more[] = {"b", "c"};
+    words.push_back("a");
+    words.push_back("d");
+    words.insert(1, more, more + 2);
+    words.erase(0);
+    passed = words.get_length() == 3 && words.at(0) == "b" && words.at(2) == "d";
+    print_test_result("Non-trivial shift", passed);
+
+    // Test range insert from the array's own elements, after, before and around pos
+    Array<int> self(12);
+    for (int i = 0; i < 4; ++i) {
+        self.push_back(i);
+    }
+    self.insert(1, self.data() + 2, self.data() + 4);
+    int after[] = {0, 2, 3, 1, 2, 3};
+    passed = self.get_length() == 6 && std::equal(after, after + 6, self.data());
+    self.insert(5, self.data(), self.data() + 2);
+    self.insert(1, self.data(), self.data() + 3);
+    int around[] = {0, 0, 2, 3, 2, 3, 1, 2, 0, 2, 3};
+    passed &= self.get_length() == 11 && std::equal(around, around + 11, self.data());
+    Array<std::string> self_words(6);
+    self_words.push_back("a");
+    self_words.push_back("b");
+    self_words.push_back("c");
+    self_words.insert(1, self_words.data(), self_words.data() + 3);
+    passed &= self_words.get_length() == 6 && self_words.at(1) == "a" && self_words.at(2) == "b" &&
+              self_words.at(3) == "c" && self_words.at(4) == "b" && self_words.at(5) == "c";
+    print_test_result("Self range insert", passed);
+}
+
+// Test Gap Buffer
+void test_gap_buffer() {
+    std::cout << "\nTesting Gap Buffer:" << std::endl;
+
+    Gap_Buffer<int> buffer(2);
+    bool passed = true;
+
+    // Test empty buffer
+    passed &= buffer.empty();
+    passed &= buffer.cursor() == 0;
+    print_test_result("Empty buffer", passed);
+
+    // Test insert at cursor (grows past the initial capacity)
+    for (int i = 0; i < 5; ++i) {
+        buffer.insert(i);
+    }
+    passed = buffer.size() == 5 && buffer.cursor() == 5 && buffer.at(4) == 4;
+    print_test_result("Insert", passed);
+
+    // Test move cursor and insert in the middle
+    buffer.move_cursor(2);
+    buffer.insert(9);
+    passed = buffer.size() == 6 && buffer.at(2) == 9 && buffer.at(3) == 2 && buffer.cursor() == 3;
+    print_test_result("Move cursor", passed);
+
+    // Test erase around the cursor
+    buffer.erase_before();
+    buffer.erase_after();
+    passed = buffer.size() == 4 && buffer.at(1) == 1 && buffer.at(2) == 3;
+    print_test_result("Erase at cursor", passed);
+
+    // Test indexed erase and push_back
+    buffer.erase(0);
+    buffer.push_back(7);
+    passed = buffer.size() == 4 && buffer.at(0) == 1 && buffer.at(3) == 7;
+    print_test_result("Erase and push back", passed);
+
+    // Test copy keeps the gap layout
+    Gap_Buffer<int> copy = buffer;
+    copy.move_cursor(0);
+    passed = copy.size() == 4 && copy.at(3) == 7 && buffer.at(0) == 1;
+    print_test_result("Copy", passed);
+
+    // Test inserting the buffer's own elements while it grows and while the cursor moves
+    Gap_Buffer<std::string> words(1);
+    words.insert(std::string(40, 'x'));
+    words.insert(words.at(0));
+    words.push_back(words.at(0));
+    words.insert(0, words.at(2));
+    passed = words.size() == 4;
+    for (size_t i = 0; i < words.size(); ++i) {
+        passed &= words.at(i) == std::string(40, 'x');
+    }
+    print_test_result("Self insert", passed);
+}
+
+// Test SIMD search and reductions
+void test_simd_search() {
+    std::cout << "\nTesting SIMD Search:" << std::endl;
+
+    Array<int> array(100);
+    for (int i = 0; i < 37; ++i) {
+        array.push_back(i % 10 - 3);
+    }
+    bool passed = true;
+
+    // Test find, including a hit in the scalar tail and a miss
+    passed &= simd_find(array, 4) == 7;
+    passed &= simd_find(array.data(), array.get_length(), 3) == 6;
+    passed &= simd_find(array.data() + 30, 7, 3) == 6;
+    passed &= simd_find(array, 42) == static_cast<size_t>(-1);
+    print_test_result("Find", passed);
+
+    // Test count
+    passed = simd_count(array, 0) == 4 && simd_count(array, -3) == 4;
+    print_test_result("Count", passed);
+
+    // Test min, max and sum
+    passed = simd_min(array) == -3 && simd_max(array) == 6;
+    passed &= simd_sum(array) == 3 * 15 + (-3 - 2 - 1 + 0 + 1 + 2 + 3);
+    print_test_result("Min max sum", passed);
+
+    // Test contains_any
+    int hits[] = {100, 5};
+    int misses[] = {100, 200};
+    passed = simd_contains_any(array, hits, 2) && !simd_contains_any(array, misses, 2);
+    print_test_result("Contains any", passed);
+
+    // Test doubles and a type without a vector kernel
+    double reals[] = {1.5, -2.0, 8.25, 3.0, 0.5};
+    short shorts[] = {4, -9, 7};
+    passed = simd_find(reals, 5, 3.0) == 3 && simd_min(reals, 5) == -2.0 && simd_max(reals, 5) == 8.25;
+    passed &= simd_sum(reals, 5) == 11.25 && simd_sum(shorts, 3) == 2 && simd_min(shorts, 3) == -9;
+    print_test_result("Other element types", passed);
+
+    // Test both halves of a gap buffer
+    Gap_Buffer<int> buffer;
+    for (int i = 0; i < 20; ++i) {
+        buffer.insert(i);
+    }
+    buffer.move_cursor(9);
+    passed = simd_find(buffer, 15) == 15 && simd_find(buffer, 3) == 3 && simd_sum(buffer) == 190;
+    print_test_result("Gap buffer chunks", passed);
+}
+
+// Test Small Array
+void test_small_array() {
+    std::cout << "\nTesting Small Array:" << std::endl;
+
+    Small_Array<int, 4> array;
+    bool passed = true;
+
+    // Test empty array
+    passed &= array.empty();
+    passed &= !array.is_spilled();
+    print_test_result("Empty array", passed);
+
+    // Test inline push_back, insert and erase
+    array.push_back(1);
+    array.push_back(3);
+    array.insert(1, 2);
+    array.push_front(0);
+    passed = array.get_length() == 4 && !array.is_spilled() && array.at(1) == 1 && array.at(2) == 2;
+    print_test_result("Inline operations", passed);
+
+    // Test spill to the heap
+    array.push_back(4);
+    passed = array.get_length() == 5 && array.is_spilled() && array.at(4) == 4;
+    print_test_result("Spill", passed);
+
+    // Test erase and update_at
+    array.erase(0);
+    array.update_at(0, 10);
+    passed = array.get_length() == 4 && array.at(0) == 10 && array.at(3) == 4;
+    print_test_result("Erase and update", passed);
+
+    // Test move steals the heap buffer
+    const int* heap = array.data();
+    Small_Array<int, 4> moved = std::move(array);
+    passed = moved.data() == heap && moved.get_length() == 4 && array.empty() && !array.is_spilled();
+    print_test_result("Move semantics", passed);
+
+    // Test non-trivial elements, range insert and copy
+    Small_Array<std::string, 2> words;
+    std::string more[] = {"b", "c", "d"};
+    words.push_back("a");
+    words.push_back("e");
+    words.insert(1, more, more + 3);
+    words.erase(0, 2);
+    Small_Array<std::string, 2> copy = words;
+    passed = copy.get_length() == 3 && copy.at(0) == "c" && copy.at(2) == "e" && words.at(1) == "d";
+    words.clear();
+    passed &= words.empty() && copy.get_length() == 3;
+    print_test_result("Non-trivial elements", passed);
+
+    // Test range insert from the array's own elements while it spills
+    copy.insert(0, copy.data(), copy.data() + copy.get_length());
+    passed = copy.get_length() == 6 && copy.at(0) == "c" && copy.at(3) == "c" && copy.at(5) == "e";
+    print_test_result("Self range insert", passed);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// Test Mapped Array
+void test_mapped_array() {
+    std::cout << "\nTesting Mapped Array:" << std::endl;
+
+    const std::string path = "mapped_array_test.bin";
+    std::remove(path.c_str());
+    bool passed = true;
+
+    // Test create and grow past the initial capacity
+    {
+        Mapped_Array<int> array(path, Map_Mode::read_write, 4);
+        passed &= array.empty();
+        for (int i = 0; i < 100; ++i) {
+            array.push_back(i * i);
+        }
+        array.update_at(0, -1);
+        array.flush();
+        passed &= array.get_length() == 100 && array.get_capacity() >= 100 && array.at(99) == 99 * 99;
+    }
+    print_test_result("Create and grow", passed);
+
+    // Test reopen read-only
+    {
+        Mapped_Array<int> array(path, Map_Mode::read_only);
+        passed = array.get_length() == 100 && array.at(0) == -1 && array.at(10) == 100 && array.read_only();
+        try {
+            array.push_back(1);
+            passed = false;
+        } catch (const std::logic_error&) {
+        }
+    }
+    print_test_result("Reopen read-only", passed);
+
+    // Test move leaves an empty array behind
+    {
+        Mapped_Array<int> array(path, Map_Mode::read_only);
+        Mapped_Array<int> moved = std::move(array);
+        passed = moved.get_length() == 100 && array.empty() && array.get_length() == 0 &&
+                 array.get_capacity() == 0 && array.data() == nullptr;
+        array.print();
+    }
+    print_test_result("Move semantics", passed);
+
+    // Test element size check
+    try {
+        Mapped_Array<double> wrong(path, Map_Mode::read_only);
+        passed = false;
+    } catch (const std::runtime_error&) {
+        passed = true;
+    }
+    print_test_result("Header check", passed);
+
+    std::remove(path.c_str());
+}
+#endif
+
+// Test Sorted Array
+void test_sorted_array() {
+    std::cout << "\nTesting Sorted Array:" << std::endl;
+
+    Array<int> source(10);
+    int values[] = {7, 3, 9, 3, 1, 12, 3};
+    source.insert(0, values, values + 7);
+    Sorted_Array<int> array(source);
+    bool passed = true;
+
+    // Test sorted order
+    passed &= array.size() == 7 && array.at(0) == 1 && array.at(6) == 12;
+    print_test_result("Sorted on construction", passed);
+
+    // Test binary search
+    passed = array.lower_bound(3) == 1 && array.upper_bound(3) == 4 && array.lower_bound(13) == 7;
+    passed &= array.contains(9) && !array.contains(8);
+    print_test_result("Binary search", passed);
+
+    // Test Eytzinger index gives the same answers
+    array.build_index();
+    passed = array.has_index() && array.lower_bound(3) == 1 && array.upper_bound(3) == 4;
+    passed &= array.equal_range(7) == std::make_pair<size_t, size_t>(4, 5);
+    passed &= array.lower_bound(0) == 0 && array.lower_bound(13) == 7 && !array.contains(8);
+    print_test_result("Eytzinger search", passed);
+
+    // Test insert keeps order and drops the index
+    array.insert(8);
+    passed = !array.has_index() && array.contains(8) && array.at(5) == 8;
+    print_test_result("Insert", passed);
+}
+
+// Test Structure-of-Arrays container
+void test_soa_array() {
+    std::cout << "\nTesting SoA Array:" << std::endl;
+
+    SoA_Array<int, double, std::string> records;
+    bool passed = true;
+
+    // Test empty container
+    passed &= records.empty();
+    print_test_result("Empty container", passed);
+
+    // Test push_back and insert
+    records.push_back(1, 1.5, "one");
+    records.push_back(std::make_tuple(3, 3.5, std::string("three")));
+    records.insert(1, 2, 2.5, "two");
+    passed = records.size() == 3 && records.at(1).get<2>() == "two";
+    print_test_result("Push back and insert", passed);
+
+    // Test contiguous columns
+    auto ids = records.column<0>();
+    int sum = 0;
+    for (int id : ids) {
+        sum += id;
+    }
+    passed = ids.size() == 3 && sum == 6 && records.column<1>().data()[2] == 3.5;
+    print_test_result("Columns", passed);
+
+    // Test row proxy writes through and update_at
+    records[0].get<1>() = 9.0;
+    records.update_at(2, 30, 30.5, "thirty");
+    std::tuple<int, double, std::string> row = records.at(0);
+    passed = std::get<1>(row) == 9.0 && records.at(2).get<0>() == 30;
+    print_test_result("Row access", passed);
+
+    // Test a field whose copy throws leaves every column as it was
+    struct Fragile {
+        bool fail = false;
+        Fragile() = default;
+        explicit Fragile(bool fail) : fail(fail) {}
+        Fragile(const Fragile& other) : fail(other.fail) {
+            if (fail) throw std::runtime_error("copy failed");
+        }
+        Fragile& operator=(const Fragile&) = default;
+    };
+    SoA_Array<int, Fragile> fragile;
+    fragile.push_back(1, Fragile());
+    bool threw = false;
+    try {
+        fragile.insert(0, 2, Fragile(true));
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    passed = threw && fragile.size() == 1 && fragile.column<0>().size() == 1 && fragile.column<1>().size() == 1 &&
+             fragile.at(0).get<0>() == 1;
+    print_test_result("Failed insert rolls back", passed);
+
+    // Test erase and clear
+    records.erase(0);
+    passed = records.size() == 2 && records.at(0).get<0>() == 2;
+    records.clear();
+    passed &= records.empty();
+    print_test_result("Erase and clear", passed);
+}
+
+// Test Packed Array
+void test_packed_array() {
+    std::cout << "\nTesting Packed Array:" << std::endl;
+
+    Array<int> source(1000);
+    for (int i = 0; i < 300; ++i) {
+        source.push_back(100000 + i % 13);
+    }
+    bool passed = true;
+
+    // Test frame-of-reference packing picks a small width
+    Packed_Array<int> packed(source);
+    passed &= packed.size() == 300 && packed.block_width(0) == 4;
+    passed &= packed.at(0) == 100000 && packed.at(299) == 100000 + 299 % 13;
+    passed &= packed.compression_ratio() > 4.0;
+    print_test_result("Frame of reference", passed);
+
+    // Test block decode matches random access
+    int values[Packed_Array<int>::block_size];
+    size_t count = packed.decode_block(2, values);
+    passed = count == 300 - 2 * Packed_Array<int>::block_size;
+    for (size_t i = 0; i < count; ++i) {
+        passed &= values[i] == packed.at(2 * Packed_Array<int>::block_size + i);
+    }
+    print_test_result("Block decode", passed);
+
+    // Test delta encoding over a linked list
+    Single_Linked_List<long long> list;
+    for (long long i = 0; i < 200; ++i) {
+        list.push_back(-5000 + 7 * i);
+    }
+    Packed_Array<long long> deltas(list.begin(), list.end(), Pack_Encoding::delta);
+    passed = deltas.at(0) == -5000 && deltas.at(150) == -5000 + 7 * 150 && deltas.block_width(0) == 4;
+    print_test_result("Delta encoding", passed);
+
+    // Test a fixed width that is too small
+    try {
+        Packed_Array<int> narrow(source.data(), source.data() + source.get_length(), Pack_Encoding::plain, 8);
+        passed = false;
+    } catch (const std::invalid_argument&) {
+        passed = true;
+    }
+    print_test_result("Fixed width check", passed);
+}
+
+// Test parallel algorithms
+void test_parallel() {
+    std::cout << "\nTesting Parallel Algorithms:" << std::endl;
+
+    Thread_Pool pool(4);
+    const size_t size = 50000;
+    Array<int> array(size);
+    for (size_t i = 0; i < size; ++i) {
+        array.push_back(static_cast<int>((i * 7919) % size));
+    }
+    bool passed = true;
+
+    // Test parallel sort with a small grain so it really splits
+    parallel_sort(pool, array.data(), array.get_length(), std::less<int>(), 1000);
+    for (size_t i = 0; i < size; ++i) {
+        passed &= array.at(i) == static_cast<int>(i);
+    }
+    print_test_result("Parallel sort", passed);
+
+    // Test parallel for_each and transform
+    parallel_for_each(pool, array.data(), array.get_length(), [](int& value) { value *= 2; }, 1000);
+    parallel_transform(pool, array.data(), array.get_length(), array.data(), [](int value) { return value + 1; }, 1000);
+    passed = array.at(0) == 1 && array.at(size - 1) == static_cast<int>(2 * (size - 1) + 1);
+    print_test_result("Parallel for_each and transform", passed);
+
+    // Test parallel reduce
+    long long sum = parallel_reduce(pool, array.data(), array.get_length(), 0LL,
+                                    [](long long total, int value) { return total + value; }, 1000);
+    passed = sum == static_cast<long long>(size) * static_cast<long long>(size);
+    print_test_result("Parallel reduce", passed);
+
+    // Test exceptions reach the caller
+    try {
+        parallel_for(pool, size, [](size_t begin, size_t) {
+            if (begin >= 25000) throw std::runtime_error("task failed");
+        }, 1000);
+        passed = false;
+    } catch (const std::runtime_error&) {
+        passed = true;
+    }
+    print_test_result("Exception propagation", passed);
+}
+
+// Test radix sort
+void test_radix_sort() {
+    std::cout << "\nTesting Radix Sort:" << std::endl;
+
+    const size_t size = 5000;
+    Array<int> ints(size);
+    for (size_t i = 0; i < size; ++i) {
+        ints.push_back(static_cast<int>((i * 7919) % size) - 2500);
+    }
+    radix_sort(ints);
+    bool passed = true;
+    for (size_t i = 0; i < size; ++i) {
+        passed &= ints.at(i) == static_cast<int>(i) - 2500;
+    }
+    print_test_result("Signed integers", passed);
+
+    Array<double> doubles(size);
+    for (size_t i = 0; i < size; ++i) {
+        doubles.push_back((static_cast<double>((i * 31) % size) - 2500.0) / 8.0);
+    }
+    radix_sort<8>(doubles);
+    passed = std::is_sorted(doubles.data(), doubles.data() + size) && doubles.at(0) == -312.5;
+    print_test_result("Floating point with 8-bit digits", passed);
+
+    // Stable sort of records by key: equal keys keep their original order
+    Array<std::pair<uint64_t, size_t>> records(size);
+    for (size_t i = 0; i < size; ++i) {
+        records.push_back({(i * 13) % 100 * 1000000007ULL, i});
+    }
+    radix_sort(records, [](const std::pair<uint64_t, size_t>& record) { return record.first; });
+    passed = true;
+    for (size_t i = 1; i < size; ++i) {
+        const auto& a = records.at(i - 1);
+        const auto& b = records.at(i);
+        passed &= a.first < b.first || (a.first == b.first && a.second < b.second);
+    }
+    print_test_result("Stable sort by key", passed);
+
+    // Below the radix threshold each key is still extracted once
+    std::string names[] = {"pear", "fig", "apple", "kiwi", "plum", "date", "lime"};
+    size_t key_calls = 0;
+    radix_sort(names, 7, [&key_calls](const std::string& name) {
+        ++key_calls;
+        return name.size();
+    });
+    passed = key_calls == 7 && names[0] == "fig" && names[1] == "pear" && names[2] == "kiwi" &&
+             names[3] == "plum" && names[4] == "date" && names[5] == "lime" && names[6] == "apple";
+    print_test_result("Small stable sort by key", passed);
+
+    // Linked lists relink their nodes
+    Single_Linked_List<int> single;
+    Doubly_Linked_List<std::string> doubly;
+    for (int i = 0; i < 1000; ++i) {
+        single.push_back((i * 37) % 1000 - 500);
+        doubly.push_back(std::to_string((i * 37) % 1000));
+    }
+    single.radix_sort();
+    doubly.radix_sort([](const std::string& value) { return std::stoi(value); });
+    passed = true;
+    int expected = -500;
+    for (int value : single) {
+        passed &= value == expected++;
+    }
+    expected = 0;
+    for (const std::string& value : doubly) {
+        passed &= value == std::to_string(expected++);
+    }
+    print_test_result("Linked list sort", passed);
+}
+
+// Test node allocation accounting
+void test_memory_stats() {
+    std::cout << "\nTesting Memory Stats:" << std::endl;
+
+#if defined(DS_TRACK_ALLOCATIONS)
+    Memory_Stats before = Single_Linked_List<int>::type_memory_stats();
+    bool passed;
+    {
+        Single_Linked_List<int> list;
+        for (int i = 0; i < 100; ++i) {
+            list.push_back(i);
+        }
+        for (int i = 0; i < 40; ++i) {
+            list.pop_front();
+        }
+        Memory_Stats stats = list.memory_stats();
+        size_t node_bytes = stats.peak_bytes / 100;
+        passed = stats.allocations == 100 && stats.frees == 40 && stats.live_bytes == 60 * node_bytes &&
+                 node_bytes >= sizeof(int) + sizeof(void*);
+        print_test_result("Per-instance counters", passed);
+
+        Single_Linked_List<int> moved(std::move(list));
+        passed = moved.memory_stats().live_bytes == stats.live_bytes && list.memory_stats().allocations == 0;
+        Single_Linked_List<int> copy(moved);
+        passed &= copy.memory_stats().allocations == 60 && moved.memory_stats().allocations == 100;
+        print_test_result("Counters follow moved nodes", passed);
+    }
+    Memory_Stats after = Single_Linked_List<int>::type_memory_stats();
+    passed = after.allocations - before.allocations == 160 && after.frees - before.frees == 160 &&
+             after.live_bytes == before.live_bytes;
+    print_test_result("Per-type counters", passed);
+
+    Linked_Queue<int> queue;
+    Linked_Stack<int> stack;
+    Doubly_Linked_List<int> doubly;
+    for (int i = 0; i < 10; ++i) {
+        queue.enqueue(i);
+        stack.push(i);
+        doubly.push_back(i);
+    }
+    queue.clear();
+    stack.pop();
+    doubly.erase(3);
+    passed = queue.memory_stats().live_bytes == 0 && queue.memory_stats().frees == 10 &&
+             stack.memory_stats().frees == 1 && doubly.memory_stats().frees == 1;
+    bool named = false;
+    for (const auto& entry : memory_stats_by_type()) {
+        named |= entry.first == "Linked_Stack" && entry.second.live_bytes >= 9 * sizeof(int);
+    }
+    passed &= named;
+    print_test_result("Queue, stack and doubly linked list", passed);
+#else
+    // Without DS_TRACK_ALLOCATIONS the tracking base takes no space and counts nothing
+    Single_Linked_List<int> list;
+    list.push_back(1);
+    bool passed = sizeof(Single_Linked_List<int>) == 2 * sizeof(void*) + sizeof(size_t) &&
+                  list.memory_stats().allocations == 0 && memory_stats_by_type().empty();
+    print_test_result("Disabled tracking is free", passed);
+#endif
+}
+
+// Test hardware counter capture; without PMU access every event must read as unavailable
+void test_perf_counters() {
+    std::cout << "\nTesting Perf Counters:" << std::endl;
+
+    Perf_Counters counters;
+    volatile long sink = 0;
+    counters.start();
+    for (long i = 0; i < 100000; ++i) {
+        sink = sink + i;
+    }
+    counters.stop();
+    Perf_Sample sample = counters.sample();
+    bool passed = true;
+    for (size_t i = 0; i < perf_event_count; ++i) {
+        Perf_Event event = static_cast<Perf_Event>(i);
+        // An available event may still never have been scheduled
+        passed &= !sample.has(event) || (counters.available(event) && sample[event] >= 0);
+    }
+    if (sample.has(Perf_Event::instructions)) {
+        passed &= sample[Perf_Event::instructions] >= 100000;
+    }
+    print_test_result("Available events are counted", passed);
+
+    Perf_Sample per = sample.per(100000);
+    counters.reset();
+    passed = std::string(perf_event_name(Perf_Event::dtlb_misses)) == "dtlb_misses" &&
+             per.has(Perf_Event::cycles) == sample.has(Perf_Event::cycles);
+    // Nothing has run since the reset, so no event has a count, not even zero
+    for (size_t i = 0; i < perf_event_count; ++i) {
+        passed &= !counters.sample().has(static_cast<Perf_Event>(i));
+    }
+    print_test_result("Reset and per-operation counts", passed);
+}
+
+// Test latency histograms
+void test_latency_histogram() {
+    std::cout << "\nTesting Latency Histogram:" << std::endl;
+
+    Latency_Histogram histogram;
+    for (uint64_t value = 1; value <= 100000; ++value) {
+        histogram.record(value);
+    }
+    bool passed = histogram.count() == 100000 && histogram.min() == 1 && histogram.max() == 100000 &&
+                  histogram.mean() == 50000.5;
+    for (double percent : {50.0, 90.0, 99.0, 99.9}) {
+        double exact = percent * 1000.0;
+        double reported = static_cast<double>(histogram.percentile(percent));
+        passed &= reported >= exact && reported <= exact * (1.0 + 1.0 / 64.0);
+    }
+    passed &= histogram.percentile(100) == 100000 && histogram.percentile(0) == 1;
+    print_test_result("Percentiles within bucket precision", passed);
+
+    // Small values are exact and the full 64-bit range has a bucket
+    Latency_Histogram edges;
+    edges.record(0);
+    edges.record(63);
+    edges.record(UINT64_MAX);
+    passed = edges.percentile(33) == 0 && edges.percentile(66) == 63 && edges.percentile(100) == UINT64_MAX;
+    print_test_result("Exact small values and full range", passed);
+
+    // Histograms recorded on separate threads merge into the combined distribution
+    Latency_Histogram low;
+    Latency_Histogram high;
+    std::thread first([&] { for (uint64_t value = 1; value <= 50000; ++value) low.record(value); });
+    std::thread second([&] { for (uint64_t value = 50001; value <= 100000; ++value) high.record(value); });
+    first.join();
+    second.join();
+    low.merge(high);
+    passed = low.count() == histogram.count() && low.max() == histogram.max() &&
+             low.percentile(99.9) == histogram.percentile(99.9) && low.percentile(50) == histogram.percentile(50);
+    low.reset();
+    passed &= low.count() == 0 && low.percentile(50) == 0;
+    print_test_result("Merge across threads", passed);
+
+    Timed_Queue<Linked_Queue<int>> queue;
+    Timed_Stack<Linked_Stack<int>> stack;
+    for (int i = 0; i < 100; ++i) {
+        queue.enqueue(i);
+        stack.push(i);
+    }
+    int value = 0;
+    queue.dequeue(value);
+    queue.dequeue();
+    stack.pop(value);
+    passed = value == 99 && queue.get_front() == 2 && queue.enqueue_latency().count() == 100 &&
+             queue.dequeue_latency().count() == 2 && stack.push_latency().count() == 100 &&
+             stack.pop_latency().count() == 1 && queue.enqueue_latency().max() >= queue.enqueue_latency().percentile(50);
+    print_test_result("Timed queue and stack", passed);
+}
+
+// Test infix to postfix conversion
+void test_infix_to_postfix() {
+    std::cout << "\nTesting Infix To Postfix:" << std::endl;
+
+    bool passed = infix_to_postfix("1 + 2") == "1 2 +" && infix_to_postfix("(12+30)*2") == "12 30 + 2 *";
+    print_test_result("Simple expressions", passed);
+
+    // Every operator of equal or higher precedence is popped, not just the top one
+    passed = infix_to_postfix("1 - 2 * 3 + 4") == "1 2 3 * - 4 +" && infix_to_postfix("8 / 4 / 2") == "8 4 / 2 /";
+    print_test_result("Precedence and associativity", passed);
+
+    char buffer[64];
+    char* end = infix_to_postfix(std::string_view("7 * (6 - 5)"), buffer);
+    passed = std::string(buffer, end) == "7 6 5 - *";
+    print_test_result("Output iterator", passed);
+
+    passed = false;
+    try {
+        infix_to_postfix("(1 + 2");
+    } catch (const std::invalid_argument&) {
+        passed = true;
+    }
+    print_test_result("Unbalanced parentheses", passed);
+
+    // Multi-digit operands, left operand first
+    passed = expression_evaluation(infix_to_postfix("(12 + 30) * 2 - 100 / 4")) == 59 &&
+             expression_evaluation("10 4 -") == 6 && expression_evaluation("1000000 3 /") == 333333;
+    print_test_result("Postfix evaluation", passed);
+
+    passed = infix_to_postfix("1.5 * (2.5e3 + .5)") == "1.5 2.5e3 .5 + *" &&
+             expression_evaluation<double>(infix_to_postfix("1.5 * (2.5e3 + .5)")) == 3750.75;
+    print_test_result("Decimal numbers", passed);
+
+    passed = false;
+    try {
+        expression_evaluation("9223372036854775807 1 +");
+    } catch (const std::runtime_error&) {
+        passed = true;
+    }
+    print_test_result("Overflow is reported", passed);
+}
+
+// Test compiled Calc programs
+void test_calc_program() {
+    std::cout << "\nTesting Calc Program:" << std::endl;
+
+    Calc_Program<long> program = compile("(12 + 30) * 2 - 100 / 4");
+    print_test_result("Compile and evaluate", evaluate(program) == 59);
+
+    bool passed = evaluate(compile("10 - 4 - 3")) == 3 && evaluate(compile("2 * 3 + 4 * 5")) == 26 &&
+                  evaluate(compile("((7))")) == 7 && evaluate(compile<double>("1 / 4")) == 0.25;
+    print_test_result("Precedence and associativity", passed);
+
+    // The compiled program can be evaluated repeatedly
+    long total = 0;
+    for (int i = 0; i < 1000; ++i) {
+        total += evaluate(program);
+    }
+    print_test_result("Repeated evaluation", total == 59000);
+
+    // Malformed input reports a status and an offset
+    Calc_Program<long> bad;
+    size_t pos = 0;
+    passed = calc_compile("1 + * 2", bad, &pos) == Calc_Status::missing_operand && pos == 4 && bad.empty();
+    passed &= calc_compile("(1 + 2", bad) == Calc_Status::unbalanced_parentheses;
+    passed &= calc_compile("1 + $", bad) == Calc_Status::unexpected_character;
+    passed &= calc_compile("", bad) == Calc_Status::empty_expression;
+    passed &= calc_compile("99999999999999999999", bad) == Calc_Status::number_out_of_range;
+    print_test_result("Compile errors", passed);
+
+    passed = evaluate(compile<double>("2.5e3 / 1e3 + .25")) == 2.75 && evaluate(compile("123456789 * 10")) == 1234567890;
+    passed &= calc_compile("1.5", bad) == Calc_Status::unexpected_character;
+    Calc_Program<double> bad_double;
+    passed &= calc_compile("1e999", bad_double) == Calc_Status::number_out_of_range;
+#ifdef __SIZEOF_INT128__
+    calc_int128 wide = 9223372036854775807;
+    Calc_Program<calc_int128> bad_wide;
+    passed &= evaluate(compile<calc_int128>("9223372036854775807 * 4 - 3")) == wide * 4 - 3;
+    passed &= calc_compile("999999999999999999999999999999999999999999", bad_wide) == Calc_Status::number_out_of_range;
+#endif
+    print_test_result("Numbers", passed);
+
+    long result = 0;
+    passed = calc_evaluate(compile("9223372036854775807 + 1"), result) == Calc_Status::overflow &&
+             calc_evaluate(compile("(0 - 9223372036854775807 - 1) / (0 - 1)"), result) == Calc_Status::overflow &&
+             calc_evaluate(compile("4294967296 * 4294967296"), result) == Calc_Status::overflow &&
+             calc_evaluate(compile("(0 - 9223372036854775807 - 1) / 1"), result) == Calc_Status::ok;
+    print_test_result("Overflow", passed);
+
+    passed = calc_evaluate(compile("5 / (3 - 3)"), result) == Calc_Status::division_by_zero;
+    try {
+        compile("2 )");
+        passed = false;
+    } catch (const std::invalid_argument&) {
+    }
+    print_test_result("Evaluation errors", passed);
+}
+
+// Test batched Calc evaluation
+void test_calc_batch() {
+    std::cout << "\nTesting Calc Batch:" << std::endl;
+
+    Thread_Pool pool(3);
+    std::vector<std::string> texts;
+    for (int i = 0; i < 1000; ++i) {
+        texts.push_back(std::to_string(i) + " * 2 + (" + std::to_string(i) + " - 1)");
+    }
+    texts[500] = "1 / 0";
+    texts[700] = "1 +";
+    std::vector<std::string_view> expressions(texts.begin(), texts.end());
+    std::vector<long> results(texts.size());
+    std::vector<Calc_Status> statuses(texts.size());
+
+    size_t failed = evaluate_batch(pool, expressions.data(), expressions.size(), results.data(), statuses.data(), 16);
+    bool passed = failed == 2 && statuses[500] == Calc_Status::division_by_zero &&
+                  statuses[700] == Calc_Status::missing_operand && results[500] == 0;
+    for (int i = 0; i < 1000; ++i) {
+        if (i != 500 && i != 700) passed &= results[i] == 3 * i - 1;
+    }
+    print_test_result("Batch of expressions", passed);
+
+    std::vector<double> line_results;
+    std::vector<Calc_Status> line_statuses;
+    failed = evaluate_lines(pool, "1 + 2\r\n3 / 4\n\n10 * 10", line_results, &line_statuses);
+    passed = failed == 1 && line_results.size() == 4 && line_results[0] == 3 && line_results[1] == 0.75 &&
+             line_statuses[2] == Calc_Status::empty_expression && line_results[3] == 100;
+    print_test_result("Newline-separated buffer", passed);
+}
+
+// Test variables and columnar Calc evaluation
+void test_calc_columns() {
+    std::cout << "\nTesting Calc Columns:" << std::endl;
+
+    Calc_Program<long> program = compile("(a + b) * c - a / 2");
+    long values[] = {10, 4, 3};
+    bool passed = program.variables().size() == 3 && program.variable_index("c") == 2 &&
+                  evaluate(program, values) == 37;
+    print_test_result("Variables", passed);
+
+    SoA_Array<long, long, long> table;
+    const size_t rows = 3000;
+    for (size_t i = 0; i < rows; ++i) {
+        table.push_back(static_cast<long>(i), static_cast<long>(i % 7), static_cast<long>(i % 5) + 1);
+    }
+    std::vector<const long*> columns = bind_columns(program, {{"c", table.column<2>().data()},
+                                                               {"a", table.column<0>().data()},
+                                                               {"b", table.column<1>().data()}});
+    std::vector<long> out(rows);
+    evaluate_columns(program, columns, rows, out.data());
+    passed = true;
+    for (size_t i = 0; i < rows; ++i) {
+        long row[] = {table[i].get<0>(), table[i].get<1>(), table[i].get<2>()};
+        passed &= out[i] == evaluate(program, row);
+    }
+    print_test_result("Columnar evaluation", passed);
+
+    std::vector<long> constant(rows);
+    evaluate_columns(compile("6 * 7"), {}, rows, constant.data());
+    passed = constant[0] == 42 && constant[rows - 1] == 42;
+    passed &= calc_evaluate_columns(compile("a / (b - b)"), columns.data(), rows, out.data()) ==
+              Calc_Status::division_by_zero;
+    passed &= calc_evaluate(program, values[0]) == Calc_Status::unbound_variable;
+    passed &= calc_evaluate_columns(compile("a * 4611686018427387904"), columns.data(), rows, out.data()) ==
+              Calc_Status::overflow;
+    print_test_result("Constants and errors", passed);
+}
+
+// Test the compiled expression caches
+void test_calc_cache() {
+    std::cout << "\nTesting Calc Cache:" << std::endl;
+
+    Calc_Cache<long> cache(2);
+    bool passed = cache.evaluate("1 + 2") == 3 && cache.evaluate("1 + 2") == 3 && cache.evaluate("2 * 5") == 10;
+    Calc_Cache_Stats stats = cache.stats();
+    passed &= stats.hits == 1 && stats.misses == 2 && stats.evictions == 0 && stats.size == 2;
+    print_test_result("Hits and misses", passed);
+
+    // "2 * 5" is the least recently used entry once "1 + 2" is touched again
+    cache.get("1 + 2");
+    cache.get("7 - 1");
+    stats = cache.stats();
+    passed = stats.evictions == 1 && cache.size() == 2 && cache.find("2 * 5") == nullptr &&
+             cache.find("1 + 2") != nullptr;
+    print_test_result("Least recently used eviction", passed);
+
+    passed = false;
+    try {
+        cache.get("1 +");
+    } catch (const std::invalid_argument&) {
+        passed = cache.size() == 2;
+    }
+    print_test_result("Compile errors are not cached", passed);
+
+    Sharded_Calc_Cache<long> shared(64, 4);
+    Thread_Pool pool(4);
+    std::atomic<bool> correct(true);
+    parallel_for(pool, 4000, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            long value = static_cast<long>(i % 100);
+            if (shared.evaluate(std::to_string(value) + " * 2") != value * 2) correct = false;
+        }
+    }, 100);
+    stats = shared.stats();
+    passed = correct && stats.hits + stats.misses == 4000 && stats.size <= stats.capacity && stats.capacity == 64;
+    print_test_result("Sharded cache across threads", passed);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// Test streaming Calc evaluation over files
+void test_calc_stream() {
+    std::cout << "\nTesting Calc Stream:" << std::endl;
+
+    const std::string input_path = "calc_stream_input.txt";
+    const std::string output_path = "calc_stream_output.txt";
+    std::string input;
+    std::string expected;
+    for (int i = 0; i < 2000; ++i) {
+        input += std::to_string(i) + " * 3 - 1\n";
+        expected += std::to_string(i * 3 - 1) + "\n";
+    }
+    input += "4 / 0\r\n2 +";
+    expected += "error: division by zero\nerror: missing operand\n";
+    {
+        Output_Sink writer(input_path, 256);
+        writer.write(input);
+    }
+    auto read_file = [](const std::string& path) {
+        Mapped_File file(path);
+        return std::string(file.view());
+    };
+
+    Calc_Stream_Stats stats = evaluate_file(input_path, output_path);
+    bool passed = stats.lines == 2002 && stats.errors == 2 && read_file(output_path) == expected;
+    print_test_result("Sequential file", passed);
+
+    // Small chunks and a two-thread pool force several waves of chunks
+    Thread_Pool pool(2);
+    {
+        Mapped_File file(input_path);
+        Output_Sink out(output_path, 1024);
+        stats = evaluate_stream(pool, file.view(), out, 500);
+    }
+    passed = stats.lines == 2002 && stats.errors == 2 && read_file(output_path) == expected;
+    print_test_result("Parallel file keeps order", passed);
+
+    // The strtod/snprintf fallback must read and print what charconv would
+    char real_text[64];
+    passed = true;
+    for (double real : {0.1, 2750.75, 1e-300, 1.7976931348623157e308, -3.0, 1.0 / 3.0}) {
+        passed &= std::string(real_text, calc_detail::format_float(real_text, real)) ==
+                  std::string(real_text, calc_detail::format_number(real_text, real));
+        std::string written(real_text, calc_detail::format_float(real_text, real));
+        double read = 0.0;
+        Calc_Status status = Calc_Status::unexpected_character;
+        const char* begin = written.data() + (real < 0 ? 1 : 0);
+        passed &= calc_detail::parse_float(begin, written.data() + written.size(), read, status) ==
+                  written.data() + written.size() && status == Calc_Status::ok && read == (real < 0 ? -real : real);
+    }
+    double huge = 0.0;
+    Calc_Status huge_status = Calc_Status::ok;
+    const char* huge_text = "1e999";
+    passed &= calc_detail::parse_float(huge_text, huge_text + 5, huge, huge_status) == nullptr &&
+              huge_status == Calc_Status::number_out_of_range;
+    print_test_result("Float text without charconv", passed);
+
+#ifdef __SIZEOF_INT128__
+    char text[64];
+    calc_int128 lowest = -(calc_int128(1) << 126) * 2;
+    passed = std::string(text, calc_detail::format_number(text, lowest)) == "-170141183460469231731687303715884105728";
+    print_test_result("128-bit output", passed);
+#endif
+
+    std::remove(input_path.c_str());
+    std::remove(output_path.c_str());
+}
+#endif
+
+// Test the Calc optimizer
+void test_calc_optimizer() {
+    std::cout << "\nTesting Calc Optimizer:" << std::endl;
+
+    Calc_Optimize_Stats stats;
+    Calc_Program<long> folded = optimize(compile("(2 * 3 + 4) * (10 - 5)"), &stats);
+    bool passed = folded.instructions().size() == 1 && evaluate(folded) == 50 && stats.folded == 4 &&
+                  stats.nodes_before == 9 && stats.nodes_after == 1;
+    print_test_result("Constant folding", passed);
+
+    Calc_Program<long> original = compile("(a + b) * (b + a) + (a + b) * 1 + c * 0 + (c - c)");
+    Calc_Program<long> optimized = optimize(original, &stats);
+    long values[] = {3, 4, 5};
+    passed = evaluate(optimized, values) == evaluate(original, values) && stats.shared >= 2 &&
+             stats.identities == 5 && stats.nodes_after < stats.nodes_before && optimized.locals() == 1;
+    print_test_result("Shared subexpressions and identities", passed);
+
+    // Floating point keeps x + 0 and x * 0, which are not identities there
+    Calc_Program<double> real = optimize(compile<double>("x + 0 + x * 0"), &stats);
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    passed = stats.identities == 0 && std::isnan(evaluate(real, &nan));
+    print_test_result("Floating point identities", passed);
+
+    // Division by zero is left for evaluation to report
+    long result = 0;
+    passed = calc_evaluate(optimize(compile("1 / (2 - 2)")), result) == Calc_Status::division_by_zero;
+    print_test_result("Runtime errors kept", passed);
+}
+
+// Test incremental re-evaluation of dependent formulas
+void test_calc_sheet() {
+    std::cout << "\nTesting Calc Sheet:" << std::endl;
+
+    Calc_Sheet<long> sheet;
+    sheet.set_value("price", 20);
+    sheet.set_value("quantity", 3);
+    sheet.set_formula("subtotal", "price * quantity");
+    sheet.set_formula("total", "subtotal + shipping");
+    sheet.set_value("shipping", 5);
+    sheet.set_value("rate", 2);
+    sheet.set_formula("fee", "rate * 10");
+    bool passed = sheet.recalculate() == 3 && sheet.value("total") == 65 && sheet.value("fee") == 20;
+    print_test_result("Formulas over cells", passed);
+
+    // Only the downstream cone of a change is evaluated
+    sheet.set_value("quantity", 4);
+    passed = sheet.dirty_count() == 2 && sheet.recalculate() == 2 && sheet.value("total") == 85;
+    sheet.set_formula("subtotal", "price * quantity - 10");
+    passed &= sheet.recalculate() == 2 && sheet.value("total") == 75 && sheet.recalculate() == 0;
+    print_test_result("Only dirty cells recalculated", passed);
+
+    passed = false;
+    try {
+        sheet.set_formula("price", "total / 2");
+    } catch (const std::invalid_argument&) {
+        passed = sheet.dirty_count() == 0 && sheet.value("price") == 20;
+    }
+    print_test_result("Cycles rejected", passed);
+
+    sheet.set_formula("unit", "total / quantity");
+    sheet.set_formula("later", "unit + missing");
+    sheet.set_value("quantity", 0);
+    sheet.recalculate();
+    passed = sheet.status("unit") == Calc_Status::division_by_zero &&
+             sheet.status("later") == Calc_Status::division_by_zero && sheet.status("missing") == Calc_Status::unbound_variable;
+    sheet.set_value("quantity", 5);
+    sheet.set_value("missing", 1);
+    sheet.recalculate();
+    passed &= sheet.value("later") == 20;
+    print_test_result("Errors travel downstream", passed);
+
+    // A wide grid evaluated level by level on a pool matches the sequential result
+    Calc_Sheet<long> grid;
+    Calc_Sheet<long> reference;
+    const int width = 600;
+    for (int column = 0; column < width; ++column) {
+        std::string name = "r0c" + std::to_string(column);
+        grid.set_value(name, column);
+        reference.set_value(name, column);
+    }
+    for (int row = 1; row < 5; ++row) {
+        for (int column = 0; column < width; ++column) {
+            std::string above = "r" + std::to_string(row - 1) + "c";
+            std::string formula = above + std::to_string(column) + " + " + above + std::to_string((column + 1) % width);
+            std::string name = "r" + std::to_string(row) + "c" + std::to_string(column);
+            grid.set_formula(name, formula);
+            reference.set_formula(name, formula);
+        }
+    }
+    Thread_Pool pool(3);
+    passed = grid.recalculate(pool) == 4 * width && reference.recalculate() == 4 * width;
+    grid.set_value("r0c7", 1000);
+    reference.set_value("r0c7", 1000);
+    passed &= grid.recalculate(pool) == 2 + 3 + 4 + 5 && reference.recalculate() == 14;
+    for (int column = 0; column < width; ++column) {
+        std::string name = "r4c" + std::to_string(column);
+        passed &= grid.value(name) == reference.value(name);
+    }
+    print_test_result("Parallel recalculation", passed);
+}
+
+#if defined(__linux__)
+// Test the Calc protocol and the socket server
+void test_calc_server() {
+    std::cout << "\nTesting Calc Server:" << std::endl;
+
+    std::string_view batch[] = {"1 + 2", "(40 + 2) * 10", "1 / 0", "2 +"};
+    std::string frame;
+    calc_encode_request(batch, 4, frame);
+    std::string_view payload;
+    size_t consumed = 0;
+    std::vector<std::string_view> decoded;
+    bool passed = calc_next_frame(std::string_view(frame).substr(0, 7), payload, consumed) == Calc_Frame::incomplete &&
+                  calc_next_frame(frame, payload, consumed) == Calc_Frame::complete && consumed == frame.size() &&
+                  calc_decode_request(payload, decoded) && decoded.size() == 4 && decoded[1] == "(40 + 2) * 10";
+    passed &= !calc_decode_request(payload.substr(0, payload.size() - 1), decoded);
+    print_test_result("Protocol frames", passed);
+
+    const std::string path = "calc_server_test.sock";
+    Calc_Server<long> server(path, 2);
+    std::thread serving([&server] { server.run(); });
+    {
+        Calc_Client<long> first(path);
+        Calc_Client<long> second(path);
+        std::vector<long> values;
+        std::vector<Calc_Status> statuses;
+        first.evaluate(batch, 4, values, statuses);
+        passed = values[0] == 3 && values[1] == 420 && statuses[2] == Calc_Status::division_by_zero &&
+                 statuses[3] == Calc_Status::missing_operand && values[3] == 0;
+        for (int i = 0; i < 100; ++i) {
+            second.evaluate(batch, 2, values, statuses);
+            passed &= values.size() == 2 && values[1] == 420;
+        }
+        first.evaluate(batch, 0, values, statuses);
+        passed &= values.empty();
+    }
+    server.stop();
+    serving.join();
+    Calc_Server_Stats stats = server.stats();
+    // Each distinct expression misses once; "2 +" never compiles, so it is never cached
+    passed &= stats.connections == 2 && stats.batches == 102 && stats.expressions == 204 && stats.errors == 2 &&
+              server.cache_stats().misses == 4;
+    print_test_result("Batches over a Unix socket", passed);
+
+    // A client that sends megabytes of requests before reading any reply gets them all
+    Calc_Server<long> throttled(path, 1);
+    std::thread throttled_serving([&throttled] { throttled.run(); });
+    {
+        const size_t batches = 400;
+        std::vector<std::string_view> sevens(1000, "7");
+        std::string requests;
+        for (size_t i = 0; i < batches; ++i) {
+            calc_encode_request(sevens.data(), sevens.size(), requests);
+        }
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address = calc_detail::socket_address(path);
+        passed = ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0;
+        std::thread sender([fd, &requests] {
+            size_t sent = 0;
+            while (sent < requests.size()) {
+                ssize_t written = ::send(fd, requests.data() + sent, requests.size() - sent, MSG_NOSIGNAL);
+                if (written <= 0) return;
+                sent += static_cast<size_t>(written);
+            }
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::string replies;
+        std::vector<long> values;
+        std::vector<Calc_Status> statuses;
+        char chunk[65536];
+        size_t answered = 0;
+        while (passed && answered < batches) {
+            std::string_view pending(replies);
+            size_t used = 0;
+            while (calc_next_frame(pending, payload, consumed) == Calc_Frame::complete) {
+                passed &= calc_decode_reply(payload, values, statuses) && values.size() == 1000 && values[999] == 7;
+                pending.remove_prefix(consumed);
+                used += consumed;
+                ++answered;
+            }
+            replies.erase(0, used);
+            if (answered == batches) break;
+            ssize_t received = ::recv(fd, chunk, sizeof(chunk), 0);
+            passed &= received > 0;
+            if (received > 0) replies.append(chunk, static_cast<size_t>(received));
+        }
+        sender.join();
+        ::close(fd);
+        passed &= answered == batches;
+    }
+    throttled.stop();
+    throttled_serving.join();
+    passed &= throttled.stats().batches == 400 && throttled.stats().accept_failures == 0;
+    print_test_result("Client that reads late", passed);
+
+    // With no descriptor left for an epoll set, every loop fails and run()
+    // reports it instead of a loop thread terminating the process. UBSan's
+    // vptr check needs a pipe, so under it the throw logs a spurious report.
+    Calc_Server<long> starved(path, 2);
+    int lowest_free = ::dup(0);
+    ::close(lowest_free);
+    rlimit limit{};
+    ::getrlimit(RLIMIT_NOFILE, &limit);
+    rlimit lowered = limit;
+    lowered.rlim_cur = static_cast<rlim_t>(lowest_free);
+    ::setrlimit(RLIMIT_NOFILE, &lowered);
+    std::exception_ptr error;
+    try {
+        starved.run();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    ::setrlimit(RLIMIT_NOFILE, &limit);
+    passed = false;
+    try {
+        if (error) std::rethrow_exception(error);
+    } catch (const std::system_error& failure) {
+        passed = failure.code() == std::errc::too_many_files_open;
+    }
+    print_test_result("Failed loop stops run", passed);
+}
+#endif
+
 int main() {
     std::cout << "Starting Data Structures Tests..." << std::endl;
 
@@ -318,7 +1558,44 @@ int main() {
     test_linked_stack();
     test_array_stack();
     test_linked_list_array();
+    test_array_ranges();
+    test_gap_buffer();
+    test_simd_search();
+    test_small_array();
+#if defined(__unix__) || defined(__APPLE__)
+    test_mapped_array();
+#endif
+    test_sorted_array();
+    test_soa_array();
+    test_packed_array();
+    test_parallel();
+    test_radix_sort();
+    test_memory_stats();
+    test_perf_counters();
+    test_latency_histogram();
+    test_infix_to_postfix();
+    test_calc_program();
+    test_calc_batch();
+    test_calc_columns();
+    test_calc_cache();
+    test_calc_optimizer();
+    test_calc_sheet();
+#if defined(__unix__) || defined(__APPLE__)
+    test_calc_stream();
+#endif
+#if defined(__linux__)
+    test_calc_server();
+#endif
+
+#if defined(DS_TRACK_ALLOCATIONS)
+    std::cout << "\nNode allocations by container:" << std::endl;
+    print_memory_stats(std::cout);
+#endif
 
     std::cout << "\nAll tests completed!" << std::endl;
+    if (failed_tests != 0) {
+        std::cout << failed_tests << " checks FAILED" << std::endl;
+        return 1;
+    }
     return 0;
 }